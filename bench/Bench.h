@@ -0,0 +1,50 @@
+#ifndef MY_BENCH_H
+#define MY_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string_view>
+
+#include <CommonDef.h>
+
+namespace my::bench {
+    // Every benchmark takes the arguments that follow its name on the command line and returns the exit code.
+    using Run = i32 (*)(std::span<char* const> args);
+
+    struct Entry
+    {
+        std::string_view name;
+        std::string_view usage;
+        Run              run;
+    };
+
+    i32 RunTree(std::span<char* const> args);
+    i32 RunConcurrent(std::span<char* const> args);
+    i32 RunFindBatch(std::span<char* const> args);
+    i32 RunFlat(std::span<char* const> args);
+
+    // The average time of one of count operations done by func, in nanoseconds.
+    template <typename Func>
+    double NanosecondsPer(const usize count, Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(count);
+    }
+
+    // The index-th argument as a count, or fallback if there are not that many.
+    inline usize CountArg(const std::span<char* const> args, const usize index, const usize fallback)
+    {
+        return index < args.size() ? std::strtoull(args[index], nullptr, 10) : fallback;
+    }
+
+    inline volatile u64 Sink = 0;
+
+    // Keeps the compiler from dropping the work that produced value.
+    inline void Consume(const u64 value) noexcept { Sink = value; }
+} // namespace my::bench
+
+#endif // MY_BENCH_H
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdio>
+#include <latch>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <ConcurrentHashMap.h>
+#include <HashMap.h>
+
+#include "Bench.h"
+
+namespace {
+    struct Config
+    {
+        usize threads;
+        usize readPercent;
+        usize keys;
+        usize operations; // Per thread.
+    };
+
+    // What ConcurrentHashMap is up against: one HashMap behind one reader-writer lock.
+    class LockedHashMap
+    {
+    private:
+        mutable std::shared_mutex m_Mutex;
+        my::HashMap<u64, u64>     m_Map;
+
+    public:
+        bool Insert(const u64 key, const u64 value)
+        {
+            std::unique_lock lock(m_Mutex);
+            return m_Map.Insert(key, value);
+        }
+        bool ContainsKey(const u64 key) const
+        {
+            std::shared_lock lock(m_Mutex);
+            return m_Map.ContainsKey(key);
+        }
+        void Reserve(const usize count) { m_Map.Reserve(count); }
+    };
+
+    // Fills map with every key, then lets each thread read or overwrite random keys, readPercent of the time
+    // reading, and returns the time of one operation across all threads in nanoseconds.
+    template <typename Map>
+    double RunOne(Map& map, const Config& config)
+    {
+        map.Reserve(config.keys);
+        for (u64 key = 0; key < config.keys; ++key)
+            map.Insert(key, key);
+
+        std::latch               start(static_cast<ptrdiff>(config.threads) + 1);
+        std::vector<std::thread> threads;
+        threads.reserve(config.threads);
+        for (usize i = 0; i < config.threads; ++i)
+        {
+            threads.emplace_back([&, i] {
+                u64   state = 0x9E3779B97F4A7C15 * (i + 1);
+                usize found = 0;
+                start.arrive_and_wait();
+                for (usize op = 0; op < config.operations; ++op)
+                {
+                    // xorshift64, a generator cheap enough not to show up next to the map.
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+                    const u64 key = state % config.keys;
+                    if ((state >> 32) % 100 < config.readPercent)
+                        found += map.ContainsKey(key);
+                    else
+                        map.Insert(key, state);
+                }
+                my::bench::Consume(found);
+            });
+        }
+
+        const usize total = config.threads * config.operations;
+        return my::bench::NanosecondsPer(total, [&] {
+            start.arrive_and_wait();
+            for (auto& thread : threads)
+                thread.join();
+        });
+    }
+} // namespace
+
+namespace my::bench {
+    i32 RunConcurrent(const std::span<char* const> args)
+    {
+        const Config config{
+            .threads     = CountArg(args, 0, std::max(std::thread::hardware_concurrency(), 1u)),
+            .readPercent = CountArg(args, 1, 90),
+            .keys        = CountArg(args, 2, 1'000'000),
+            .operations  = CountArg(args, 3, 10'000'000),
+        };
+        if (config.threads == 0 || config.keys == 0 || config.readPercent > 100)
+        {
+            std::fprintf(stderr, "The concurrent benchmark needs a thread, a key and a read share of at most 100.\n");
+            return 1;
+        }
+
+        std::printf("%zu threads, %zu%% reads, %zu keys, %zu operations per thread, per operation:\n",
+                    config.threads, config.readPercent, config.keys, config.operations);
+        {
+            ConcurrentHashMap<u64, u64> map;
+            const double                time = RunOne(map, config);
+            std::printf("%-17s %7.1f ns  (%zu shards)\n", "ConcurrentHashMap", time, map.ShardCount());
+        }
+        {
+            LockedHashMap map;
+            std::printf("%-17s %7.1f ns\n", "Locked HashMap", RunOne(map, config));
+        }
+        return 0;
+    }
+} // namespace my::bench
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <HashMap.h>
+
+#include "Bench.h"
+
+namespace {
+    u64 SumFound(const std::span<u64* const> values) noexcept
+    {
+        u64 sum = 0;
+        for (const u64* value : values)
+            sum += value ? *value : 0;
+        return sum;
+    }
+} // namespace
+
+namespace my::bench {
+    i32 RunFindBatch(const std::span<char* const> args)
+    {
+        const usize keyCount    = CountArg(args, 0, 4'000'000);
+        const usize lookupCount = CountArg(args, 1, 4'000'000);
+        const usize hitPercent  = CountArg(args, 2, 50);
+        const usize batch       = CountArg(args, 3, 256);
+        if (keyCount == 0 || batch == 0 || hitPercent > 100)
+        {
+            std::fprintf(stderr, "The findbatch benchmark needs a key, a batch and a hit share of at most 100.\n");
+            return 1;
+        }
+
+        std::mt19937_64   random(1);
+        HashMap<u64, u64> map;
+        std::vector<u64>  keys(keyCount);
+        map.Reserve(keyCount);
+        for (auto& key : keys)
+        {
+            key = random();
+            map.Insert(key, key);
+        }
+        // Misses are fresh random keys, which are next to never in the map.
+        std::vector<u64> lookups(lookupCount);
+        for (auto& key : lookups)
+            key = random() % 100 < hitPercent ? keys[random() % keyCount] : random();
+        std::vector<u64*> values(lookupCount);
+
+        std::printf("%zu keys, %zu lookups, %zu%% hits, batches of %zu, per lookup:\n", keyCount, lookupCount,
+                    hitPercent, batch);
+        // Each is run twice and the second run reported, the first one pays for faulting in values.
+        for (usize run = 0; run < 2; ++run)
+        {
+            const double loop = NanosecondsPer(lookupCount, [&] {
+                for (usize i = 0; i < lookupCount; ++i)
+                    values[i] = map.Find(lookups[i]);
+            });
+            Consume(SumFound(values));
+            const double batched = NanosecondsPer(lookupCount, [&] {
+                for (usize i = 0; i < lookupCount; i += batch)
+                {
+                    const usize count = std::min(batch, lookupCount - i);
+                    map.FindBatch(std::span<const u64>(lookups.data() + i, count),
+                                  std::span<u64*>(values.data() + i, count));
+                }
+            });
+            Consume(SumFound(values));
+            if (run == 1)
+                std::printf("%-10s %7.1f ns\n%-10s %7.1f ns\n", "Find loop", loop, "FindBatch", batched);
+        }
+        return 0;
+    }
+} // namespace my::bench
@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <BinaryTree.h>
+#include <FlatMap.h>
+#include <HashMap.h>
+
+#include "Bench.h"
+
+namespace {
+    // Builds the container out of pairs, in whatever way suits it, and then looks up every key of lookups,
+    // all of which are in it.
+    template <typename Build, typename Lookup>
+    void RunOne(const char* name, const std::vector<my::Pair<u32, u32>>& pairs, const std::vector<u32>& lookups,
+                Build&& build, Lookup&& lookup)
+    {
+        decltype(build()) container;
+        const double      construct = my::bench::NanosecondsPer(pairs.size(), [&] { container = build(); });
+        const double      search    = my::bench::NanosecondsPer(lookups.size(), [&] {
+            usize found = 0;
+            for (const u32 key : lookups)
+                found += lookup(container, key);
+            my::bench::Consume(found);
+        });
+        std::printf("%-18s build %7.1f ns  search %7.1f ns\n", name, construct, search);
+    }
+
+    template <typename Map>
+    bool FindIn(const Map& map, const u32 key) noexcept
+    {
+        return map.Find(key) != nullptr;
+    }
+
+    template <typename Tree>
+    bool SearchIn(const Tree& tree, const u32 key) noexcept
+    {
+        return tree.Search(key);
+    }
+} // namespace
+
+namespace my::bench {
+    i32 RunFlat(const std::span<char* const> args)
+    {
+        const usize keyCount    = CountArg(args, 0, 4'000'000);
+        const usize lookupCount = CountArg(args, 1, 4'000'000);
+        if (keyCount == 0)
+        {
+            std::fprintf(stderr, "The flat benchmark needs at least one key.\n");
+            return 1;
+        }
+
+        std::mt19937                random(1);
+        std::vector<Pair<u32, u32>> pairs(keyCount);
+        for (auto& pair : pairs)
+        {
+            pair.first  = random();
+            pair.second = pair.first;
+        }
+        std::vector<u32> lookups(lookupCount);
+        for (auto& key : lookups)
+            key = pairs[random() % keyCount].first;
+
+        // The trees and the HashMap are built one insertion at a time, the FlatMaps from all pairs at once,
+        // which is how each of them is meant to be filled.
+        std::printf("%zu random keys, %zu lookups, per operation:\n", keyCount, lookupCount);
+        RunOne(
+            "FlatMap sorted", pairs, lookups,
+            [&] { return FlatMap<u32, u32, std::less<>, SortedLayout>(pairs.begin(), pairs.end()); },
+            FindIn<FlatMap<u32, u32, std::less<>, SortedLayout>>);
+        RunOne(
+            "FlatMap eytzinger", pairs, lookups,
+            [&] { return FlatMap<u32, u32, std::less<>, EytzingerLayout>(pairs.begin(), pairs.end()); },
+            FindIn<FlatMap<u32, u32, std::less<>, EytzingerLayout>>);
+        RunOne(
+            "HashMap", pairs, lookups,
+            [&] {
+                HashMap<u32, u32> map;
+                for (const auto& pair : pairs)
+                    map.Insert(pair.first, pair.second);
+                return map;
+            },
+            FindIn<HashMap<u32, u32>>);
+        RunOne(
+            "AVLTree", pairs, lookups,
+            [&] {
+                AVLTree<u32> tree;
+                for (const auto& pair : pairs)
+                    tree.Insert(pair.first);
+                return tree;
+            },
+            SearchIn<AVLTree<u32>>);
+        RunOne(
+            "BinaryTree", pairs, lookups,
+            [&] {
+                BinaryTree<u32> tree;
+                for (const auto& pair : pairs)
+                    tree.Insert(pair.first);
+                return tree;
+            },
+            SearchIn<BinaryTree<u32>>);
+        return 0;
+    }
+} // namespace my::bench
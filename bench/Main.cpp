@@ -0,0 +1,32 @@
+#include <array>
+#include <cstdio>
+#include <span>
+
+#include "Bench.h"
+
+namespace {
+    constexpr std::array Entries = {
+        my::bench::Entry{ "tree", "[keys = 50000000] [lookups = 5000000] [order = all|random|sorted|reverse]",
+                          my::bench::RunTree },
+        my::bench::Entry{ "concurrent", "[threads = hardware threads] [read % = 90] [keys = 1000000] "
+                                        "[operations per thread = 10000000]",
+                          my::bench::RunConcurrent },
+        my::bench::Entry{ "findbatch", "[keys = 4000000] [lookups = 4000000] [hit % = 50] [batch = 256]",
+                          my::bench::RunFindBatch },
+        my::bench::Entry{ "flat", "[keys = 4000000] [lookups = 4000000]", my::bench::RunFlat },
+    };
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    const std::span<char* const> args(argv, static_cast<usize>(argc));
+    for (const auto& entry : Entries)
+        if (args.size() > 1 && args[1] == entry.name)
+            return entry.run(args.subspan(2));
+
+    std::fprintf(stderr, "Usage: %s <benchmark> [arguments]\n", args.empty() ? "MinLib-Bench" : args[0]);
+    for (const auto& entry : Entries)
+        std::fprintf(stderr, "  %.*s %.*s\n", static_cast<int>(entry.name.size()), entry.name.data(),
+                     static_cast<int>(entry.usage.size()), entry.usage.data());
+    return 1;
+}
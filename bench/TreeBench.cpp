@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <BTree.h>
+#include <BinaryTree.h>
+
+#include "Bench.h"
+
+namespace {
+    enum class Order
+    {
+        Random,
+        Sorted,
+        Reverse,
+    };
+
+    struct OrderEntry
+    {
+        std::string_view name;
+        Order            order;
+    };
+
+    constexpr OrderEntry Orders[] = {
+        { "random", Order::Random },
+        { "sorted", Order::Sorted },
+        { "reverse", Order::Reverse },
+    };
+
+    // Ordered input turns the unbalanced BinaryTree into a list that every insertion walks to the end, so it
+    // only gets this many keys there, anything close to the other trees' count would take hours.
+    constexpr usize UnbalancedOrderedKeys = 20'000;
+
+    // Random keys, duplicates included, inserted in the given order, and lookups of keys that are all in the
+    // tree.
+    struct Workload
+    {
+        std::vector<u32> keys;
+        std::vector<u32> lookups;
+    };
+
+    Workload MakeWorkload(const usize keyCount, const usize lookupCount, const Order order)
+    {
+        std::mt19937 random(1);
+        Workload     workload;
+        workload.keys.resize(keyCount);
+        for (auto& key : workload.keys)
+            key = random();
+        if (order == Order::Sorted)
+            std::sort(workload.keys.begin(), workload.keys.end());
+        else if (order == Order::Reverse)
+            std::sort(workload.keys.begin(), workload.keys.end(), std::greater<>());
+        workload.lookups.resize(lookupCount);
+        for (auto& key : workload.lookups)
+            key = workload.keys[random() % keyCount];
+        return workload;
+    }
+
+    // BinaryTree is a set, so it stores a key where BTree stores a key and a value, which only favours it.
+    template <typename Tree>
+    void RunOne(const char* name, const Workload& workload)
+    {
+        Tree         tree;
+        const double insert = my::bench::NanosecondsPer(workload.keys.size(), [&] {
+            for (const u32 key : workload.keys)
+            {
+                if constexpr (requires { tree.Insert(key, key); })
+                    tree.Insert(key, key);
+                else
+                    tree.Insert(key);
+            }
+        });
+        const double search = my::bench::NanosecondsPer(workload.lookups.size(), [&] {
+            usize found = 0;
+            for (const u32 key : workload.lookups)
+                found += tree.Search(key);
+            my::bench::Consume(found);
+        });
+        std::printf("%-14s insert %7.1f ns  search %7.1f ns  height %zu\n", name, insert, search, tree.Height());
+    }
+
+    void RunOrder(const OrderEntry& entry, const usize keyCount, const usize lookupCount)
+    {
+        std::printf("%.*s order, %zu keys, %zu lookups, per operation:\n", static_cast<int>(entry.name.size()),
+                    entry.name.data(), keyCount, lookupCount);
+        {
+            const Workload workload = MakeWorkload(keyCount, lookupCount, entry.order);
+            RunOne<my::BTree<u32, u32>>("BTree", workload);
+            RunOne<my::AVLTree<u32>>("AVLTree", workload);
+            RunOne<my::RedBlackTree<u32>>("RedBlackTree", workload);
+            if (entry.order == Order::Random || keyCount <= UnbalancedOrderedKeys)
+            {
+                RunOne<my::BinaryTree<u32>>("BinaryTree", workload);
+                return;
+            }
+        }
+        std::printf("BinaryTree on its own %zu keys:\n", UnbalancedOrderedKeys);
+        RunOne<my::BinaryTree<u32>>("BinaryTree", MakeWorkload(UnbalancedOrderedKeys, lookupCount, entry.order));
+    }
+} // namespace
+
+namespace my::bench {
+    i32 RunTree(const std::span<char* const> args)
+    {
+        const usize            keyCount    = CountArg(args, 0, 50'000'000);
+        const usize            lookupCount = CountArg(args, 1, 5'000'000);
+        const std::string_view order       = args.size() > 2 ? args[2] : "all";
+        if (keyCount == 0)
+        {
+            std::fprintf(stderr, "The tree benchmark needs at least one key.\n");
+            return 1;
+        }
+
+        bool ran = false;
+        for (const auto& entry : Orders)
+        {
+            if (order == "all" || order == entry.name)
+            {
+                RunOrder(entry, keyCount, lookupCount);
+                ran = true;
+            }
+        }
+        if (!ran)
+        {
+            std::fprintf(stderr, "The insertion order is one of random, sorted, reverse or all.\n");
+            return 1;
+        }
+        return 0;
+    }
+} // namespace my::bench
@@ -0,0 +1,327 @@
+#ifndef MY_B_TREE_H
+#define MY_B_TREE_H
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include <CommonDef.h>
+
+#include "../HashMap/Utilities/KeyArg.h"
+#include "../HashMap/Utilities/Pair.h"
+#include "../Memory/Allocator.h"
+#include "../Memory/NodePool.h"
+#include "NodeSearch.h"
+
+namespace my {
+    // An ordered map laid out as a B+ tree. Every node holds a few cache lines worth of keys, which are searched
+    // with a linear SIMD scan (see NodeSearch.h), so a lookup touches a handful of nodes where BinaryTree
+    // touches one node per level. Only the leaves hold values, they are linked to each other in key order for
+    // iteration. K and V have to be default constructible, the key and value arrays of a node are.
+    template <typename K, typename V, typename Compare = std::less<>, typename Alloc = Allocator<Pair<K, V>>>
+    class BTree
+    {
+    public:
+        // The most keys a node holds. The key array of a node, one spare slot included, takes about four cache
+        // lines.
+        static constexpr usize Capacity = std::max<usize>(8, 256 / sizeof(K)) - 1;
+        static_assert(Capacity < std::numeric_limits<u16>::max(), "Node::count has to hold Capacity + 1.");
+        // The fewest keys any node but the root holds.
+        static constexpr usize MinCount = Capacity / 2;
+
+    private:
+        // Nodes that overflow by one key are split right away, the spare slot saves checking beforehand.
+        struct Node
+        {
+            u16  count = 0;
+            bool leaf;
+
+        public:
+            explicit Node(const bool leaf) noexcept : leaf(leaf) {}
+        };
+
+        struct Leaf : Node
+        {
+            Leaf* prev = nullptr;
+            Leaf* next = nullptr;
+            K     keys[Capacity + 1];
+            V     values[Capacity + 1];
+
+        public:
+            Leaf() : Node(true) {}
+        };
+
+        // The keys of children[i] are not less than keys[i - 1] and less than keys[i].
+        struct Inner : Node
+        {
+            K     keys[Capacity + 1];
+            Node* children[Capacity + 2];
+
+        public:
+            Inner() : Node(false) {}
+        };
+
+        // The inner nodes a lookup went through and which child it took at each of them.
+        struct PathStep
+        {
+            Inner* node;
+            usize  slot;
+        };
+
+        // Every node but the root has at least MinCount + 1 children, which bounds the depth of any tree that
+        // fits into memory.
+        static constexpr usize MaxDepth = 64 / (std::bit_width(MinCount + 1) - 1) + 1;
+
+        using LeafPool  = NodePool<Leaf, Alloc>;
+        using InnerPool = NodePool<Inner, Alloc>;
+        using AllocTraits =
+            std::allocator_traits<typename std::allocator_traits<Alloc>::template rebind_alloc<Leaf>>;
+
+        static constexpr bool IsTransparent = requires { typename Compare::is_transparent; };
+
+        template <typename Q>
+        using KeyArg = typename KeyArgOf<IsTransparent>::template Type<Q, K>;
+
+        // Hands out the elements in key order as a Pair of references, keys are never given out mutably. The keys
+        // and values of a leaf sit in separate arrays for the sake of the key search, so there is no stored Pair
+        // to refer to: bind the elements with auto&& or const auto&. Pair's common reference (see Pair.h) makes
+        // this a proper bidirectional iterator all the same.
+        template <bool Const>
+        class BasicIterator
+        {
+            template <bool>
+            friend class BasicIterator;
+            friend class BTree;
+
+            using LeafPointer = std::conditional_t<Const, const Leaf*, Leaf*>;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type   = ptrdiff;
+            using value_type        = Pair<K, V>;
+            using reference         = Pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+        private:
+            struct ArrowProxy
+            {
+                reference ref;
+
+                const reference* operator->() const noexcept { return &ref; }
+            };
+
+        private:
+            const BTree* m_Tree  = nullptr;
+            LeafPointer  m_Leaf  = nullptr; // nullptr is the end.
+            usize        m_Index = 0;
+
+        private:
+            BasicIterator(const BTree* tree, LeafPointer leaf, const usize index) noexcept
+                : m_Tree(tree), m_Leaf(leaf), m_Index(index)
+            {
+                // Positions past the last key of a leaf are the first one of the next leaf.
+                if (m_Leaf && m_Index == m_Leaf->count)
+                {
+                    m_Leaf  = m_Leaf->next;
+                    m_Index = 0;
+                }
+            }
+
+        public:
+            BasicIterator() noexcept = default;
+            template <bool OtherConst>
+                requires(Const && !OtherConst)
+            BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+                : m_Tree(other.m_Tree), m_Leaf(other.m_Leaf), m_Index(other.m_Index)
+            {
+            }
+
+        public:
+            reference operator*() const noexcept
+            {
+                return reference(m_Leaf->keys[m_Index], m_Leaf->values[m_Index]);
+            }
+            ArrowProxy     operator->() const noexcept { return ArrowProxy{ **this }; }
+            BasicIterator& operator++() noexcept
+            {
+                if (++m_Index == m_Leaf->count)
+                {
+                    m_Leaf  = m_Leaf->next;
+                    m_Index = 0;
+                }
+                return *this;
+            }
+            BasicIterator operator++(const i32) noexcept
+            {
+                auto t = *this;
+                ++(*this);
+                return t;
+            }
+            BasicIterator& operator--() noexcept
+            {
+                if (!m_Leaf)
+                    m_Leaf = const_cast<LeafPointer>(m_Tree->LastLeaf());
+                else if (m_Index == 0)
+                    m_Leaf = m_Leaf->prev;
+                else
+                {
+                    --m_Index;
+                    return *this;
+                }
+                m_Index = m_Leaf->count - 1;
+                return *this;
+            }
+            BasicIterator operator--(const i32) noexcept
+            {
+                auto t = *this;
+                --(*this);
+                return t;
+            }
+
+        public:
+            friend bool operator==(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
+            {
+                return lhv.m_Leaf == rhv.m_Leaf && lhv.m_Index == rhv.m_Index;
+            }
+            friend bool operator!=(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
+            {
+                return !(lhv == rhv);
+            }
+        };
+
+    public:
+        using Iterator      = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+        static_assert(std::bidirectional_iterator<Iterator> && std::bidirectional_iterator<ConstIterator>);
+
+    private:
+        [[no_unique_address]] Compare m_Compare{};
+        LeafPool                      m_Leaves{};
+        InnerPool                     m_Inners{};
+        Node*                         m_Root  = nullptr;
+        usize                         m_Count = 0;
+
+    public:
+        BTree() = default;
+        explicit BTree(const Alloc& allocator) noexcept;
+        explicit BTree(const Compare& compare, const Alloc& allocator = Alloc());
+        BTree(const std::initializer_list<Pair<K, V>> list, const Compare& compare = Compare(),
+              const Alloc& allocator = Alloc());
+        BTree(const BTree<K, V, Compare, Alloc>& other);
+        BTree(BTree<K, V, Compare, Alloc>&& other) noexcept;
+        ~BTree();
+
+    public:
+        BTree<K, V, Compare, Alloc>& operator=(const BTree<K, V, Compare, Alloc>& other);
+        BTree<K, V, Compare, Alloc>& operator=(BTree<K, V, Compare, Alloc>&& other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value);
+
+    private:
+        void   Drop() noexcept;
+        Leaf*  CreateLeaf();
+        Inner* CreateInner();
+        void   DestroyLeaf(Leaf* leaf) noexcept;
+        void   DestroyInner(Inner* inner) noexcept;
+        // Destroys the nodes of the subtree of node one by one, for a subtree that is not part of the tree.
+        void   DestroySubtree(Node* node) noexcept;
+        // Copies the subtree of node, or moves out of it if it is not const, appending its leaves after last.
+        template <typename Src>
+        Node*  CloneSubtree(Src* node, Leaf*& last);
+        // The leaf key belongs in, recording the way down in path.
+        template <typename Q>
+        Leaf*  Descend(const Q& key, PathStep* path, usize& depth) noexcept;
+        template <typename Q>
+        const Leaf* FindLeaf(const Q& key) const noexcept;
+        const Leaf* FirstLeaf() const noexcept;
+        const Leaf* LastLeaf() const noexcept;
+        template <typename KArg, typename VArg>
+        bool   InsertImpl(KArg&& key, VArg&& value);
+        // Restores the minimum fill of leaf, which lost a key, and then that of the nodes above it.
+        void   RebalanceAfterErase(Leaf* leaf, PathStep* path, usize depth) noexcept;
+        // Drops keys[index] and children[index + 1] from node.
+        static void RemoveFromInner(Inner* node, const usize index) noexcept;
+
+    public:
+        // Returns true if the key was already there, in which case its value is overwritten.
+        bool                    Insert(const K& key, const V& value);
+        bool                    Insert(K&& key, V&& value);
+        // Returns true if the key was there.
+        template <typename Q = K>
+        bool                    Erase(const KeyArg<Q>& key);
+        template <typename Q = K>
+        V*                      Find(const KeyArg<Q>& key) noexcept;
+        template <typename Q = K>
+        const V*                Find(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        V&                      At(const KeyArg<Q>& key);
+        template <typename Q = K>
+        const V&                At(const KeyArg<Q>& key) const;
+        template <typename Q = K>
+        bool                    Search(const KeyArg<Q>& key) const noexcept;
+        const K&                FindMin() const;
+        const K&                FindMax() const;
+        // The key after and the key before key, or key itself if there is none, like BinaryTree's.
+        template <typename Q = K>
+        const K&                Successor(const KeyArg<Q>& key) const;
+        template <typename Q = K>
+        const K&                Predecessor(const KeyArg<Q>& key) const;
+        // The first element whose key is not less than key, and the first one whose key is greater.
+        template <typename Q = K>
+        ConstIterator           LowerBound(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        ConstIterator           UpperBound(const KeyArg<Q>& key) const noexcept;
+        // The elements with keys strictly between begin and end, in key order, like BinaryTree::RangeQuery().
+        template <typename Q = K>
+        std::vector<Pair<K, V>> RangeQuery(const KeyArg<Q>& begin, const KeyArg<Q>& end) const;
+        // The number of levels, zero for an empty tree.
+        usize                   Height() const noexcept;
+        void                    Clear() noexcept { Drop(); }
+        void                    Swap(BTree<K, V, Compare, Alloc>& other) noexcept;
+        constexpr Alloc         GetAllocator() const noexcept { return Alloc(m_Leaves.GetAllocator()); }
+        constexpr Compare       KeyComp() const { return m_Compare; }
+
+    public:
+        constexpr usize Size() const noexcept { return m_Count; }
+        constexpr bool  Empty() const noexcept { return m_Count == 0; }
+
+    public:
+        Iterator      begin() noexcept { return Iterator(this, const_cast<Leaf*>(FirstLeaf()), 0); }
+        Iterator      end() noexcept { return Iterator(this, nullptr, 0); }
+        ConstIterator begin() const noexcept { return cbegin(); }
+        ConstIterator end() const noexcept { return cend(); }
+        ConstIterator cbegin() const noexcept { return ConstIterator(this, FirstLeaf(), 0); }
+        ConstIterator cend() const noexcept { return ConstIterator(this, nullptr, 0); }
+
+    public:
+        friend std::ostream& operator<<(std::ostream& stream, const BTree<K, V, Compare, Alloc>& tree)
+        {
+            bool first = true;
+            stream << "{ ";
+            for (const auto pair : tree)
+            {
+                if (!first)
+                    stream << ", ";
+                stream << pair;
+                first = false;
+            }
+            stream << " }";
+            return stream;
+        }
+    };
+} // namespace my
+
+namespace my::pmr {
+    template <typename K, typename V, typename Compare = std::less<>>
+    using BTree = my::BTree<K, V, Compare, std::pmr::polymorphic_allocator<Pair<K, V>>>;
+} // namespace my::pmr
+
+#include "BTree.hpp"
+
+#endif // MY_B_TREE_H
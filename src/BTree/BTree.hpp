@@ -0,0 +1,751 @@
+#ifndef MY_B_TREE_IMPL_HPP
+#define MY_B_TREE_IMPL_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#define BTREE_TEMPLATE_DECL() template <typename K, typename V, typename Compare, typename Alloc>
+
+namespace my {
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>::BTree(const Alloc& allocator) noexcept : m_Leaves(allocator), m_Inners(allocator)
+    {
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>::BTree(const Compare& compare, const Alloc& allocator)
+        : m_Compare(compare), m_Leaves(allocator), m_Inners(allocator)
+    {
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>::BTree(const std::initializer_list<Pair<K, V>> list, const Compare& compare,
+                                       const Alloc& allocator)
+        : BTree(compare, allocator)
+    {
+        for (const auto& pair : list)
+            Insert(pair.first, pair.second);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>::BTree(const BTree<K, V, Compare, Alloc>& other)
+        : BTree(other.m_Compare, AllocTraits::select_on_container_copy_construction(other.m_Leaves.GetAllocator()))
+    {
+        if (other.m_Root)
+        {
+            Leaf* last = nullptr;
+            m_Root     = CloneSubtree<const Node>(other.m_Root, last);
+            m_Count    = other.m_Count;
+        }
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>::BTree(BTree<K, V, Compare, Alloc>&& other) noexcept
+        : m_Compare(other.m_Compare), m_Leaves(std::move(other.m_Leaves)), m_Inners(std::move(other.m_Inners)),
+          m_Root(std::exchange(other.m_Root, nullptr)), m_Count(std::exchange(other.m_Count, 0))
+    {
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>::~BTree()
+    {
+        Drop();
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>& BTree<K, V, Compare, Alloc>::operator=(const BTree<K, V, Compare, Alloc>& other)
+    {
+        if (this == &other)
+            return *this;
+
+        Drop();
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            m_Leaves.Reset(other.m_Leaves.GetAllocator());
+            m_Inners.Reset(other.m_Inners.GetAllocator());
+        }
+
+        m_Compare = other.m_Compare;
+        if (other.m_Root)
+        {
+            Leaf* last = nullptr;
+            m_Root     = CloneSubtree<const Node>(other.m_Root, last);
+            m_Count    = other.m_Count;
+        }
+        return *this;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    BTree<K, V, Compare, Alloc>& BTree<K, V, Compare, Alloc>::operator=(BTree<K, V, Compare, Alloc>&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+
+        Drop();
+        m_Compare = other.m_Compare;
+
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value &&
+                      !AllocTraits::is_always_equal::value)
+        {
+            // The nodes belong to a different memory resource, so the elements have to be moved one by one.
+            if (m_Leaves.GetAllocator() != other.m_Leaves.GetAllocator())
+            {
+                if (other.m_Root)
+                {
+                    Leaf* last = nullptr;
+                    m_Root     = CloneSubtree<Node>(other.m_Root, last);
+                    m_Count    = other.m_Count;
+                }
+                other.Drop();
+                return *this;
+            }
+        }
+
+        m_Leaves = std::move(other.m_Leaves);
+        m_Inners = std::move(other.m_Inners);
+        m_Root   = std::exchange(other.m_Root, nullptr);
+        m_Count  = std::exchange(other.m_Count, 0);
+        return *this;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::Drop() noexcept
+    {
+        // The nodes only have to be visited if they have a destructor to run, their memory goes back to the
+        // allocator a whole slab at a time.
+        if constexpr (!std::is_trivially_destructible_v<Leaf> || !std::is_trivially_destructible_v<Inner>)
+        {
+            if (m_Root)
+            {
+                // The recursion goes no deeper than the height of the tree, which stays small.
+                auto destroy = [this](auto& self, Node* node) -> void
+                {
+                    if (node->leaf)
+                    {
+                        std::destroy_at(static_cast<Leaf*>(node));
+                        return;
+                    }
+                    Inner* inner = static_cast<Inner*>(node);
+                    for (usize i = 0; i <= inner->count; ++i)
+                        self(self, inner->children[i]);
+                    std::destroy_at(inner);
+                };
+                destroy(destroy, m_Root);
+            }
+        }
+        m_Leaves.Release();
+        m_Inners.Release();
+        m_Root  = nullptr;
+        m_Count = 0;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    typename BTree<K, V, Compare, Alloc>::Leaf* BTree<K, V, Compare, Alloc>::CreateLeaf()
+    {
+        Leaf* leaf = m_Leaves.Allocate();
+        try
+        {
+            std::construct_at(leaf);
+        }
+        catch (...)
+        {
+            m_Leaves.Deallocate(leaf);
+            throw;
+        }
+        return leaf;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    typename BTree<K, V, Compare, Alloc>::Inner* BTree<K, V, Compare, Alloc>::CreateInner()
+    {
+        Inner* inner = m_Inners.Allocate();
+        try
+        {
+            std::construct_at(inner);
+        }
+        catch (...)
+        {
+            m_Inners.Deallocate(inner);
+            throw;
+        }
+        return inner;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::DestroyLeaf(Leaf* leaf) noexcept
+    {
+        std::destroy_at(leaf);
+        m_Leaves.Deallocate(leaf);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::DestroyInner(Inner* inner) noexcept
+    {
+        std::destroy_at(inner);
+        m_Inners.Deallocate(inner);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::DestroySubtree(Node* node) noexcept
+    {
+        if (node->leaf)
+        {
+            DestroyLeaf(static_cast<Leaf*>(node));
+            return;
+        }
+        Inner* inner = static_cast<Inner*>(node);
+        for (usize i = 0; i <= inner->count; ++i)
+            DestroySubtree(inner->children[i]);
+        DestroyInner(inner);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Src>
+    typename BTree<K, V, Compare, Alloc>::Node* BTree<K, V, Compare, Alloc>::CloneSubtree(Src* node, Leaf*& last)
+    {
+        using SrcLeaf  = std::conditional_t<std::is_const_v<Src>, const Leaf, Leaf>;
+        using SrcInner = std::conditional_t<std::is_const_v<Src>, const Inner, Inner>;
+
+        if (node->leaf)
+        {
+            SrcLeaf* src  = static_cast<SrcLeaf*>(node);
+            Leaf*    leaf = CreateLeaf();
+            try
+            {
+                if constexpr (std::is_const_v<Src>)
+                {
+                    std::copy(src->keys, src->keys + src->count, leaf->keys);
+                    std::copy(src->values, src->values + src->count, leaf->values);
+                }
+                else
+                {
+                    std::move(src->keys, src->keys + src->count, leaf->keys);
+                    std::move(src->values, src->values + src->count, leaf->values);
+                }
+            }
+            catch (...)
+            {
+                DestroyLeaf(leaf);
+                throw;
+            }
+            leaf->count = src->count;
+            leaf->prev  = last;
+            if (last)
+                last->next = leaf;
+            last = leaf;
+            return leaf;
+        }
+
+        SrcInner* src   = static_cast<SrcInner*>(node);
+        Inner*    inner = CreateInner();
+        usize     i     = 0;
+        try
+        {
+            std::copy(src->keys, src->keys + src->count, inner->keys);
+            inner->count = src->count;
+            for (; i <= src->count; ++i)
+                inner->children[i] = CloneSubtree<Src>(src->children[i], last);
+        }
+        catch (...)
+        {
+            // The children cloned so far are whole subtrees, the one that threw has cleaned up after itself.
+            for (usize j = 0; j < i; ++j)
+                DestroySubtree(inner->children[j]);
+            DestroyInner(inner);
+            throw;
+        }
+        return inner;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    typename BTree<K, V, Compare, Alloc>::Leaf* BTree<K, V, Compare, Alloc>::Descend(const Q& key, PathStep* path,
+                                                                                     usize& depth) noexcept
+    {
+        depth      = 0;
+        Node* node = m_Root;
+        while (!node->leaf)
+        {
+            Inner*      inner = static_cast<Inner*>(node);
+            const usize slot  = NodeUpperBound(inner->keys, inner->count, key, m_Compare);
+            path[depth++]     = { inner, slot };
+            node              = inner->children[slot];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    const typename BTree<K, V, Compare, Alloc>::Leaf* BTree<K, V, Compare, Alloc>::FindLeaf(
+        const Q& key) const noexcept
+    {
+        const Node* node = m_Root;
+        if (!node)
+            return nullptr;
+        while (!node->leaf)
+        {
+            const Inner* inner = static_cast<const Inner*>(node);
+            node               = inner->children[NodeUpperBound(inner->keys, inner->count, key, m_Compare)];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    const typename BTree<K, V, Compare, Alloc>::Leaf* BTree<K, V, Compare, Alloc>::FirstLeaf() const noexcept
+    {
+        const Node* node = m_Root;
+        if (!node)
+            return nullptr;
+        while (!node->leaf)
+            node = static_cast<const Inner*>(node)->children[0];
+        return static_cast<const Leaf*>(node);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    const typename BTree<K, V, Compare, Alloc>::Leaf* BTree<K, V, Compare, Alloc>::LastLeaf() const noexcept
+    {
+        const Node* node = m_Root;
+        if (!node)
+            return nullptr;
+        while (!node->leaf)
+            node = static_cast<const Inner*>(node)->children[node->count];
+        return static_cast<const Leaf*>(node);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename KArg, typename VArg>
+    bool BTree<K, V, Compare, Alloc>::InsertImpl(KArg&& key, VArg&& value)
+    {
+        if (!m_Root)
+        {
+            Leaf* leaf      = CreateLeaf();
+            leaf->keys[0]   = std::forward<KArg>(key);
+            leaf->values[0] = std::forward<VArg>(value);
+            leaf->count     = 1;
+            m_Root          = leaf;
+            m_Count         = 1;
+            return false;
+        }
+
+        PathStep    path[MaxDepth];
+        usize       depth = 0;
+        Leaf*       leaf  = Descend(key, path, depth);
+        const usize index = NodeLowerBound(leaf->keys, leaf->count, key, m_Compare);
+        if (index != leaf->count && !m_Compare(key, leaf->keys[index]))
+        {
+            leaf->values[index] = std::forward<VArg>(value);
+            return true;
+        }
+
+        // A full leaf splits, and so does every full node above it up to the first one with room, or else the
+        // root. Everything that can throw happens before the tree is touched: the new nodes are allocated
+        // and the element and the key the leaf splits at are copied.
+        const bool split  = leaf->count == Capacity;
+        usize      splits = 0;
+        if (split)
+            while (splits < depth && path[depth - 1 - splits].node->count == Capacity)
+                ++splits;
+        const usize inners = splits + usize(split && splits == depth);
+
+        Leaf*  sibling = nullptr;
+        Inner* spares[MaxDepth + 1];
+        usize  created = 0;
+        K      separator{};
+        K      newKey(std::forward<KArg>(key));
+        V      newValue(std::forward<VArg>(value));
+        try
+        {
+            if (split)
+            {
+                sibling = CreateLeaf();
+                for (; created < inners; ++created)
+                    spares[created] = CreateInner();
+
+                // The upper half of the Capacity + 1 keys goes to the sibling, its first key is the separator.
+                constexpr usize Half = (Capacity + 1) / 2;
+                separator = index < Half ? leaf->keys[Half - 1] : index == Half ? newKey : leaf->keys[Half];
+            }
+        }
+        catch (...)
+        {
+            while (created != 0)
+                DestroyInner(spares[--created]);
+            if (sibling)
+                DestroyLeaf(sibling);
+            throw;
+        }
+
+        std::move_backward(leaf->keys + index, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + index, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[index]   = std::move(newKey);
+        leaf->values[index] = std::move(newValue);
+        ++leaf->count;
+        ++m_Count;
+        if (!split)
+            return false;
+
+        const usize half = leaf->count / 2;
+        std::move(leaf->keys + half, leaf->keys + leaf->count, sibling->keys);
+        std::move(leaf->values + half, leaf->values + leaf->count, sibling->values);
+        sibling->count = u16(leaf->count - half);
+        leaf->count    = u16(half);
+        sibling->prev  = leaf;
+        sibling->next  = leaf->next;
+        if (sibling->next)
+            sibling->next->prev = sibling;
+        leaf->next = sibling;
+
+        // Hand the separator and the new node up until a parent has room for them.
+        Node* child = sibling;
+        usize spare = 0;
+        while (depth != 0)
+        {
+            --depth;
+            Inner*      parent = path[depth].node;
+            const usize slot   = path[depth].slot;
+            std::move_backward(parent->keys + slot, parent->keys + parent->count, parent->keys + parent->count + 1);
+            std::move_backward(parent->children + slot + 1, parent->children + parent->count + 1,
+                               parent->children + parent->count + 2);
+            parent->keys[slot]         = std::move(separator);
+            parent->children[slot + 1] = child;
+            if (++parent->count <= Capacity)
+                return false;
+
+            // The middle key moves up, the keys after it go to the new node.
+            Inner*      right = spares[spare++];
+            const usize mid   = parent->count / 2;
+            separator         = std::move(parent->keys[mid]);
+            std::move(parent->keys + mid + 1, parent->keys + parent->count, right->keys);
+            std::copy(parent->children + mid + 1, parent->children + parent->count + 1, right->children);
+            right->count  = u16(parent->count - mid - 1);
+            parent->count = u16(mid);
+            child         = right;
+        }
+
+        Inner* root       = spares[spare];
+        root->keys[0]     = std::move(separator);
+        root->children[0] = m_Root;
+        root->children[1] = child;
+        root->count       = 1;
+        m_Root            = root;
+        return false;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::RemoveFromInner(Inner* node, const usize index) noexcept
+    {
+        std::move(node->keys + index + 1, node->keys + node->count, node->keys + index);
+        std::copy(node->children + index + 2, node->children + node->count + 1, node->children + index + 1);
+        --node->count;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::RebalanceAfterErase(Leaf* leaf, PathStep* path, usize depth) noexcept
+    {
+        if (depth == 0)
+        {
+            // The root leaf may hold anything down to nothing at all.
+            if (leaf->count == 0)
+            {
+                DestroyLeaf(leaf);
+                m_Root = nullptr;
+            }
+            return;
+        }
+        if (leaf->count >= MinCount)
+            return;
+
+        // Borrow a key from a sibling that can spare one, or else merge with one of them, which takes a key
+        // away from the parent.
+        --depth;
+        Inner*      parent = path[depth].node;
+        const usize slot   = path[depth].slot;
+        Leaf*       left   = slot > 0 ? static_cast<Leaf*>(parent->children[slot - 1]) : nullptr;
+        Leaf*       right  = slot < parent->count ? static_cast<Leaf*>(parent->children[slot + 1]) : nullptr;
+        if (left && left->count > MinCount)
+        {
+            std::move_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            std::move_backward(leaf->values, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+            --left->count;
+            leaf->keys[0]          = std::move(left->keys[left->count]);
+            leaf->values[0]        = std::move(left->values[left->count]);
+            parent->keys[slot - 1] = leaf->keys[0];
+            ++leaf->count;
+            return;
+        }
+        if (right && right->count > MinCount)
+        {
+            leaf->keys[leaf->count]   = std::move(right->keys[0]);
+            leaf->values[leaf->count] = std::move(right->values[0]);
+            ++leaf->count;
+            std::move(right->keys + 1, right->keys + right->count, right->keys);
+            std::move(right->values + 1, right->values + right->count, right->values);
+            --right->count;
+            parent->keys[slot] = right->keys[0];
+            return;
+        }
+
+        // Always merge the right one of the two into the left one.
+        usize separator = slot;
+        if (left)
+        {
+            right = leaf;
+            leaf  = left;
+            --separator;
+        }
+        std::move(right->keys, right->keys + right->count, leaf->keys + leaf->count);
+        std::move(right->values, right->values + right->count, leaf->values + leaf->count);
+        leaf->count += right->count;
+        leaf->next = right->next;
+        if (leaf->next)
+            leaf->next->prev = leaf;
+        RemoveFromInner(parent, separator);
+        DestroyLeaf(right);
+
+        // Now the same for the inner nodes on the way up.
+        for (Inner* node = parent;; node = parent)
+        {
+            if (depth == 0)
+            {
+                // A root without keys has a single child left, which becomes the root.
+                if (node->count == 0)
+                {
+                    m_Root = node->children[0];
+                    DestroyInner(node);
+                }
+                return;
+            }
+            if (node->count >= MinCount)
+                return;
+
+            --depth;
+            parent                = path[depth].node;
+            const usize up        = path[depth].slot;
+            Inner*      leftNode  = up > 0 ? static_cast<Inner*>(parent->children[up - 1]) : nullptr;
+            Inner*      rightNode = up < parent->count ? static_cast<Inner*>(parent->children[up + 1]) : nullptr;
+            if (leftNode && leftNode->count > MinCount)
+            {
+                // Rotate through the parent: its separator comes down, the left sibling's last key goes up.
+                std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+                std::copy_backward(node->children, node->children + node->count + 1,
+                                   node->children + node->count + 2);
+                node->keys[0]        = std::move(parent->keys[up - 1]);
+                node->children[0]    = leftNode->children[leftNode->count];
+                parent->keys[up - 1] = std::move(leftNode->keys[leftNode->count - 1]);
+                --leftNode->count;
+                ++node->count;
+                return;
+            }
+            if (rightNode && rightNode->count > MinCount)
+            {
+                node->keys[node->count]         = std::move(parent->keys[up]);
+                node->children[node->count + 1] = rightNode->children[0];
+                parent->keys[up]                = std::move(rightNode->keys[0]);
+                std::move(rightNode->keys + 1, rightNode->keys + rightNode->count, rightNode->keys);
+                std::copy(rightNode->children + 1, rightNode->children + rightNode->count + 1, rightNode->children);
+                --rightNode->count;
+                ++node->count;
+                return;
+            }
+
+            // The separator comes down between the keys of the two nodes.
+            usize between = up;
+            if (leftNode)
+            {
+                rightNode = node;
+                node      = leftNode;
+                --between;
+            }
+            node->keys[node->count] = std::move(parent->keys[between]);
+            std::move(rightNode->keys, rightNode->keys + rightNode->count, node->keys + node->count + 1);
+            std::copy(rightNode->children, rightNode->children + rightNode->count + 1,
+                      node->children + node->count + 1);
+            node->count += rightNode->count + 1;
+            RemoveFromInner(parent, between);
+            DestroyInner(rightNode);
+        }
+    }
+
+    BTREE_TEMPLATE_DECL()
+    bool BTree<K, V, Compare, Alloc>::Insert(const K& key, const V& value)
+    {
+        return InsertImpl(key, value);
+    }
+
+    BTREE_TEMPLATE_DECL()
+    bool BTree<K, V, Compare, Alloc>::Insert(K&& key, V&& value)
+    {
+        return InsertImpl(std::move(key), std::move(value));
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    bool BTree<K, V, Compare, Alloc>::Erase(const KeyArg<Q>& key)
+    {
+        if (!m_Root)
+            return false;
+
+        PathStep    path[MaxDepth];
+        usize       depth = 0;
+        Leaf*       leaf  = Descend(key, path, depth);
+        const usize index = NodeLowerBound(leaf->keys, leaf->count, key, m_Compare);
+        if (index == leaf->count || m_Compare(key, leaf->keys[index]))
+            return false;
+
+        std::move(leaf->keys + index + 1, leaf->keys + leaf->count, leaf->keys + index);
+        std::move(leaf->values + index + 1, leaf->values + leaf->count, leaf->values + index);
+        --leaf->count;
+        --m_Count;
+        RebalanceAfterErase(leaf, path, depth);
+        return true;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    V* BTree<K, V, Compare, Alloc>::Find(const KeyArg<Q>& key) noexcept
+    {
+        return const_cast<V*>(std::as_const(*this).template Find<Q>(key));
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    const V* BTree<K, V, Compare, Alloc>::Find(const KeyArg<Q>& key) const noexcept
+    {
+        const Leaf* leaf = FindLeaf(key);
+        if (!leaf)
+            return nullptr;
+        const usize index = NodeLowerBound(leaf->keys, leaf->count, key, m_Compare);
+        if (index == leaf->count || m_Compare(key, leaf->keys[index]))
+            return nullptr;
+        return &leaf->values[index];
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    V& BTree<K, V, Compare, Alloc>::At(const KeyArg<Q>& key)
+    {
+        V* value = Find<Q>(key);
+        if (!value)
+            throw std::invalid_argument("It does not exist.");
+        return *value;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    const V& BTree<K, V, Compare, Alloc>::At(const KeyArg<Q>& key) const
+    {
+        const V* value = Find<Q>(key);
+        if (!value)
+            throw std::invalid_argument("It does not exist.");
+        return *value;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    bool BTree<K, V, Compare, Alloc>::Search(const KeyArg<Q>& key) const noexcept
+    {
+        return Find<Q>(key) != nullptr;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    const K& BTree<K, V, Compare, Alloc>::FindMin() const
+    {
+        if (!m_Root)
+            throw std::invalid_argument("It does not exist.");
+        return FirstLeaf()->keys[0];
+    }
+
+    BTREE_TEMPLATE_DECL()
+    const K& BTree<K, V, Compare, Alloc>::FindMax() const
+    {
+        if (!m_Root)
+            throw std::invalid_argument("It does not exist.");
+        const Leaf* leaf = LastLeaf();
+        return leaf->keys[leaf->count - 1];
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    const K& BTree<K, V, Compare, Alloc>::Successor(const KeyArg<Q>& key) const
+    {
+        ConstIterator it = LowerBound<Q>(key);
+        if (it == cend() || m_Compare(key, it->first))
+            throw std::invalid_argument("Value does not exist.");
+
+        const K& found = it->first;
+        return ++it == cend() ? found : it->first;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    const K& BTree<K, V, Compare, Alloc>::Predecessor(const KeyArg<Q>& key) const
+    {
+        ConstIterator it = LowerBound<Q>(key);
+        if (it == cend() || m_Compare(key, it->first))
+            throw std::invalid_argument("Value does not exist.");
+
+        const K& found = it->first;
+        return it == cbegin() ? found : (--it)->first;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    typename BTree<K, V, Compare, Alloc>::ConstIterator BTree<K, V, Compare, Alloc>::LowerBound(
+        const KeyArg<Q>& key) const noexcept
+    {
+        const Leaf* leaf = FindLeaf(key);
+        if (!leaf)
+            return cend();
+        return ConstIterator(this, leaf, NodeLowerBound(leaf->keys, leaf->count, key, m_Compare));
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    typename BTree<K, V, Compare, Alloc>::ConstIterator BTree<K, V, Compare, Alloc>::UpperBound(
+        const KeyArg<Q>& key) const noexcept
+    {
+        const Leaf* leaf = FindLeaf(key);
+        if (!leaf)
+            return cend();
+        return ConstIterator(this, leaf, NodeUpperBound(leaf->keys, leaf->count, key, m_Compare));
+    }
+
+    BTREE_TEMPLATE_DECL()
+    template <typename Q>
+    std::vector<Pair<K, V>> BTree<K, V, Compare, Alloc>::RangeQuery(const KeyArg<Q>& begin,
+                                                                   const KeyArg<Q>& end) const
+    {
+        std::vector<Pair<K, V>> pairs;
+        if (!m_Compare(begin, end))
+            return pairs;
+
+        for (auto it = UpperBound<Q>(begin); it != cend() && m_Compare(it->first, end); ++it)
+            pairs.emplace_back(it->first, it->second);
+        return pairs;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    usize BTree<K, V, Compare, Alloc>::Height() const noexcept
+    {
+        usize height = 0;
+        for (const Node* node = m_Root; node; ++height)
+            node = node->leaf ? nullptr : static_cast<const Inner*>(node)->children[0];
+        return height;
+    }
+
+    BTREE_TEMPLATE_DECL()
+    void BTree<K, V, Compare, Alloc>::Swap(BTree<K, V, Compare, Alloc>& other) noexcept
+    {
+        std::swap(m_Compare, other.m_Compare);
+        m_Leaves.Swap(other.m_Leaves);
+        m_Inners.Swap(other.m_Inners);
+        std::swap(m_Root, other.m_Root);
+        std::swap(m_Count, other.m_Count);
+    }
+} // namespace my
+
+#undef BTREE_TEMPLATE_DECL
+
+#endif // MY_B_TREE_IMPL_HPP
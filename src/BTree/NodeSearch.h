@@ -0,0 +1,174 @@
+#ifndef MY_NODE_SEARCH_H
+#define MY_NODE_SEARCH_H
+
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+#include <CommonDef.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MY_NODE_SEARCH_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#define MY_NODE_SEARCH_SSE42
+#include <nmmintrin.h>
+#endif
+
+namespace my {
+    // Searches within a single BTree node. The keys of a node are sorted, so where a key belongs is just the
+    // number of keys that come before it. That is counted with a linear scan instead of a binary search, which
+    // has no unpredictable branches and, for integer keys under the natural order, compares a whole 16 byte
+    // group of keys at once (SSE2 for 32 bit keys, SSE4.2 for 64 bit ones).
+    template <typename K, typename Q, typename Compare>
+    concept IsSimdSearchable =
+        std::same_as<K, Q> && std::integral<K> &&
+        (std::same_as<Compare, std::less<>> || std::same_as<Compare, std::less<K>>) &&
+#ifdef MY_NODE_SEARCH_SSE42
+        (sizeof(K) == 4 || sizeof(K) == 8);
+#elif defined(MY_NODE_SEARCH_SSE2)
+        sizeof(K) == 4;
+#else
+        false;
+#endif
+
+    namespace detail {
+#ifdef MY_NODE_SEARCH_SSE2
+        // Compares 16 bytes worth of keys at once, SSE only has signed compares so unsigned keys are flipped
+        // into the signed range first.
+        template <typename K>
+        struct KeyGroup
+        {
+            static constexpr usize Lanes = 16 / sizeof(K);
+
+            __m128i keys;
+
+            static __m128i Bias(const __m128i keys) noexcept
+            {
+                if constexpr (std::is_signed_v<K>)
+                    return keys;
+                else if constexpr (sizeof(K) == 4)
+                    return _mm_xor_si128(keys, _mm_set1_epi32(i32(0x80000000u)));
+                else
+                    return _mm_xor_si128(keys, _mm_set1_epi64x(i64(0x8000000000000000ull)));
+            }
+
+            static KeyGroup Load(const K* keys) noexcept
+            {
+                return { Bias(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys))) };
+            }
+
+            static KeyGroup Splat(const K key) noexcept
+            {
+                if constexpr (sizeof(K) == 4)
+                    return { Bias(_mm_set1_epi32(i32(key))) };
+                else
+                    return { Bias(_mm_set1_epi64x(i64(key))) };
+            }
+
+            // Lanes where lhv is greater than rhv, as all ones.
+            static __m128i Greater(const KeyGroup lhv, const KeyGroup rhv) noexcept
+            {
+                if constexpr (sizeof(K) == 4)
+                    return _mm_cmpgt_epi32(lhv.keys, rhv.keys);
+#ifdef MY_NODE_SEARCH_SSE42
+                else
+                    return _mm_cmpgt_epi64(lhv.keys, rhv.keys);
+#endif
+            }
+
+            static __m128i Add(const __m128i lhv, const __m128i rhv) noexcept
+            {
+                if constexpr (sizeof(K) == 4)
+                    return _mm_add_epi32(lhv, rhv);
+                else
+                    return _mm_add_epi64(lhv, rhv);
+            }
+
+            // The sum of the lanes of counts, which hold negated counts.
+            static usize Total(const __m128i counts) noexcept
+            {
+                __m128i sum = Add(counts, _mm_shuffle_epi32(counts, _MM_SHUFFLE(1, 0, 3, 2)));
+                if constexpr (sizeof(K) == 4)
+                    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+                return usize(-_mm_cvtsi128_si32(sum));
+            }
+        };
+
+        // Counts keys[i] < key when Strict and keys[i] <= key otherwise. Every group is compared, the mask of
+        // each one (minus one per matching lane) is added up and only summed across lanes at the end, so the
+        // loop has no data dependent branch. Stopping early would save loads but costs a misprediction per
+        // node, which is what the scan is there to avoid.
+        template <bool Strict, typename K>
+        usize CountBeforeSimd(const K* keys, const usize count, const K key) noexcept
+        {
+            using Group = KeyGroup<K>;
+
+            constexpr usize Lanes  = Group::Lanes;
+            const Group     needle = Group::Splat(key);
+            const auto      step   = [&](const __m128i counts, const usize i) noexcept {
+                const Group group = Group::Load(keys + i);
+                // The greater than lanes are the ones after the key when not Strict, the others are counted.
+                if constexpr (Strict)
+                    return Group::Add(counts, Group::Greater(needle, group));
+                else
+                    return Group::Add(counts, _mm_xor_si128(Group::Greater(group, needle), _mm_set1_epi32(-1)));
+            };
+
+            // Two groups per iteration into separate sums, so the compares do not wait on each other.
+            __m128i counts = _mm_setzero_si128();
+            __m128i others = _mm_setzero_si128();
+            usize   i      = 0;
+            for (; i + 2 * Lanes <= count; i += 2 * Lanes)
+            {
+                counts = step(counts, i);
+                others = step(others, i + Lanes);
+            }
+            if (i + Lanes <= count)
+            {
+                counts = step(counts, i);
+                i += Lanes;
+            }
+            counts = Group::Add(counts, others);
+            usize before = Group::Total(counts);
+            for (; i < count; ++i)
+                before += Strict ? usize(keys[i] < key) : usize(!(key < keys[i]));
+            return before;
+        }
+#endif
+
+        template <bool Strict, typename K, typename Q, typename Compare>
+        usize CountBefore(const K* keys, const usize count, const Q& key, const Compare& compare) noexcept
+        {
+#ifdef MY_NODE_SEARCH_SSE2
+            if constexpr (IsSimdSearchable<K, Q, Compare>)
+                return CountBeforeSimd<Strict>(keys, count, key);
+            else
+#endif
+            {
+                usize before = 0;
+                for (usize i = 0; i < count; ++i)
+                    before += Strict ? usize(compare(keys[i], key)) : usize(!compare(key, keys[i]));
+                return before;
+            }
+        }
+    } // namespace detail
+
+    // The index of the first key that is not less than key.
+    template <typename K, typename Q, typename Compare>
+    usize NodeLowerBound(const K* keys, const usize count, const Q& key, const Compare& compare) noexcept
+    {
+        return detail::CountBefore<true>(keys, count, key, compare);
+    }
+
+    // The index of the first key that is greater than key.
+    template <typename K, typename Q, typename Compare>
+    usize NodeUpperBound(const K* keys, const usize count, const Q& key, const Compare& compare) noexcept
+    {
+        return detail::CountBefore<false>(keys, count, key, compare);
+    }
+} // namespace my
+
+#endif // MY_NODE_SEARCH_H
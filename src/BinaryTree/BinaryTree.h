@@ -1,50 +1,230 @@
 #ifndef MY_BINARY_TREE_H
 #define MY_BINARY_TREE_H
 
+#include <concepts>
 #include <cstdint>
 #include <exception>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 #include <CommonDef.h>
 
+#include "../Memory/Allocator.h"
+#include "../Memory/NodePool.h"
+#include "FrozenTree.h"
+
 namespace my {
+    // How BinaryTree keeps its shape. NoBalance is the plain binary search tree, it degenerates into a list when
+    // the values arrive in order. AVLBalance and RedBlackBalance rotate after every Insert() and Remove() to
+    // keep the height logarithmic. AVL trees are the flatter of the two and search faster, red-black trees
+    // rotate less and so insert and remove faster.
+    struct NoBalance
+    {
+    };
+    struct AVLBalance
+    {
+    };
+    struct RedBlackBalance
+    {
+    };
+
     template <typename T>
+    concept IsBalancePolicy =
+        std::same_as<T, NoBalance> || std::same_as<T, AVLBalance> || std::same_as<T, RedBlackBalance>;
+
+    template <typename T, typename Alloc = Allocator<T>, IsBalancePolicy Balance = NoBalance>
     class BinaryTree
     {
     public:
         struct Node
         {
-            Node* left  = nullptr;
-            Node* right = nullptr;
+            Node* left   = nullptr;
+            Node* right  = nullptr;
+            Node* parent = nullptr;
+            usize size   = 1;    // The number of nodes in the subtree rooted here.
+            u8    height = 1;    // AVLBalance only, the height of the subtree rooted here.
+            bool  red    = true; // RedBlackBalance only.
             T     val{};
 
         public:
             Node();
             Node(const T& ref);
+            Node(T&& ref);
         };
 
     private:
+        using NodeAllocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+        using Pool            = NodePool<Node, Alloc>;
+
+        // The bulk traversals keep the nodes still to be visited on a small array on the stack, which is a lot
+        // faster than climbing back up through the parent links. That is enough for any balanced tree, deeper
+        // unbalanced ones finish the walk through the parent links.
+        static constexpr usize StackDepth = 128;
+
+    public:
+        // Walks the values in order, lazily, by following the parent links, so iterating allocates nothing. The
+        // values are const since changing one in place could break the order. Only Remove() of the value an
+        // iterator points at invalidates it.
+        class ConstIterator
+        {
+            friend class BinaryTree;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type   = ptrdiff;
+            using value_type        = T;
+            using pointer           = const T*;
+            using reference         = const T&;
+
+        private:
+            const BinaryTree* m_Tree = nullptr;
+            const Node*       m_Node = nullptr; // nullptr is the end.
+
+        private:
+            ConstIterator(const BinaryTree* tree, const Node* node) noexcept : m_Tree(tree), m_Node(node) {}
+
+        public:
+            ConstIterator() noexcept = default;
+
+        public:
+            reference      operator*() const noexcept { return m_Node->val; }
+            pointer        operator->() const noexcept { return &m_Node->val; }
+            ConstIterator& operator++() noexcept
+            {
+                m_Node = InOrderNext(m_Node);
+                return *this;
+            }
+            ConstIterator operator++(const i32) noexcept
+            {
+                auto t = *this;
+                ++(*this);
+                return t;
+            }
+            ConstIterator& operator--() noexcept
+            {
+                m_Node = m_Node ? InOrderPrev(m_Node) : Rightmost(m_Tree->m_Root);
+                return *this;
+            }
+            ConstIterator operator--(const i32) noexcept
+            {
+                auto t = *this;
+                --(*this);
+                return t;
+            }
+
+        public:
+            friend bool operator==(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            {
+                return lhv.m_Node == rhv.m_Node;
+            }
+            friend bool operator!=(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            {
+                return !(lhv == rhv);
+            }
+        };
+        using Iterator             = ConstIterator;
+        using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+        using ReverseIterator      = ConstReverseIterator;
+
+    private:
+        Pool  m_Pool{};
         Node* m_Root  = nullptr;
         usize m_Count = 0;
 
     public:
         BinaryTree();
-        BinaryTree(const std::initializer_list<T> list);
-        BinaryTree(const BinaryTree<T>& other);
-        BinaryTree(BinaryTree<T>&& other) noexcept;
+        explicit BinaryTree(const Alloc& allocator) noexcept;
+        BinaryTree(const std::initializer_list<T> list, const Alloc& allocator = Alloc());
+        BinaryTree(const BinaryTree<T, Alloc, Balance>& other);
+        BinaryTree(BinaryTree<T, Alloc, Balance>&& other) noexcept;
         ~BinaryTree();
 
     public:
-        BinaryTree<T>& operator=(const BinaryTree<T>& other) const;
-        BinaryTree<T>& operator=(BinaryTree<T>&& other) noexcept;
+        BinaryTree<T, Alloc, Balance>& operator=(const BinaryTree<T, Alloc, Balance>& other);
+        BinaryTree<T, Alloc, Balance>& operator=(BinaryTree<T, Alloc, Balance>&& other) noexcept(
+            NodeAllocTraits::propagate_on_container_move_assignment::value || NodeAllocTraits::is_always_equal::value);
 
     private:
         inline void Drop(const bool destructing = false);
+        template <typename... TArgs>
+        inline Node* CreateNode(TArgs&&... args);
+        inline void  DestroyNode(Node* node) noexcept;
+        // Copies the subtree of src, shape and balancing state included, returning its new root. A const src
+        // is copied from, a mutable one belongs to a tree that is being moved from.
+        template <typename Src>
+        Node*        CloneSubtree(Src* src, Node* parent);
+
+    private:
+        // Puts child where node hangs off parent, or at the root if there is no parent.
+        void         ReplaceChild(Node* parent, const Node* node, Node* child) noexcept;
+        Node*        RotateLeft(Node* node) noexcept;
+        Node*        RotateRight(Node* node) noexcept;
+        static u8    HeightOf(const Node* node) noexcept { return node ? node->height : 0; }
+        static bool  IsRed(const Node* node) noexcept { return node && node->red; }
+        static usize SizeOf(const Node* node) noexcept { return node ? node->size : 0; }
+        static void  UpdateHeight(Node* node) noexcept;
+        static void  UpdateSize(Node* node) noexcept { node->size = 1 + SizeOf(node->left) + SizeOf(node->right); }
+        // Walks up from node to the root restoring the AVL invariant.
+        void         RebalanceAVL(Node* node) noexcept;
+        void         InsertFixupRedBlack(Node* node) noexcept;
+        // node took the place of a removed black node below parent, node may be null.
+        void         RemoveFixupRedBlack(Node* node, Node* parent) noexcept;
+
+    private:
+        // Stepping through a subtree without recursion or a stack, N is Node or const Node. Leftmost() and
+        // Rightmost() take nullptr for an empty subtree.
+        template <typename N>
+        static N* Leftmost(N* node) noexcept;
+        template <typename N>
+        static N* Rightmost(N* node) noexcept;
+        template <typename N>
+        static N* InOrderNext(N* node) noexcept;
+        template <typename N>
+        static N* InOrderPrev(N* node) noexcept;
+        template <typename N>
+        static N* PreOrderNext(N* node) noexcept;
+        // The deepest leftmost leaf, where a post-order walk starts.
+        template <typename N>
+        static N* PostOrderFirst(N* node) noexcept;
+        template <typename N>
+        static N* PostOrderNext(N* node) noexcept;
+        // Hands visit the nodes of the subtree in post-order. A node is not looked at again once visit has had
+        // it, so visit may destroy it.
+        template <typename N, typename F>
+        static void PostOrderWalk(N* root, F&& visit);
+        // Height() for trees too deep for the stack.
+        usize     HeightByParents() const noexcept;
+        // The number of values less than val, or not greater than val when Inclusive.
+        template <bool Inclusive>
+        usize     CountBefore(const T& val) const noexcept;
+
+    private:
+        // The nodes in order.
+        std::vector<Node*> CollectNodes() const;
+        // Hangs a perfectly balanced subtree of the count nodes at(first) to at(first + count - 1), which are
+        // in order, off link below parent, filling in the sizes and the balancing state. Every node is linked
+        // in before at() is asked for the next one, so the subtree can be torn down whenever at() throws. The
+        // deepest level is the only one that can be incomplete, making it red keeps the black heights equal.
+        template <typename F>
+        static void LinkBalanced(Node*& link, Node* parent, const usize first, const usize count, const usize depth,
+                                 const usize red_depth, F& at);
+        // Replaces the (empty) tree with a balanced one of the count nodes at() hands out in order.
+        template <typename F>
+        void        BuildBalanced(const usize count, F&& at);
+        // Moves the values of nodes[first, last), which belong to from, into new nodes of this tree, destroying
+        // the old ones. If creating a node throws the values are moved back and nothing changes.
+        void        Rehome(std::vector<Node*>& nodes, const usize first, const usize last, BinaryTree& from);
 
     public:
         constexpr usize Size() const noexcept { return m_Count; }
         constexpr void  Clear() { Drop(); }
+        constexpr Alloc GetAllocator() const noexcept { return Alloc(m_Pool.GetAllocator()); }
 
     public:
         void           Insert(const T& val);
@@ -61,9 +241,59 @@ namespace my {
         const T&       Successor(const T& val) const;
         const T&       Predecessor(const T& val) const;
         std::vector<T> RangeQuery(const T& begin, const T& end) const;
+        // The first value that is not less than val, and the first one that is greater.
+        ConstIterator  LowerBound(const T& val) const noexcept;
+        ConstIterator  UpperBound(const T& val) const noexcept;
+        // Order statistics from the subtree sizes, without walking or copying any values. Rank() is the number
+        // of values less than val, Select() the value with k values before it, and CountRange() the number of
+        // values strictly between begin and end, which is RangeQuery(begin, end).size().
+        usize          Rank(const T& val) const noexcept;
+        const T&       Select(const usize k) const;
+        usize          CountRange(const T& begin, const T& end) const noexcept;
+        // Replaces the contents with values, which have to be in strictly ascending order, in O(n) and as a
+        // perfectly balanced tree whatever the balance policy.
+        void           BuildFromSorted(std::span<const T> values);
+        // Moves the values of other over, the ones this tree already has are dropped, leaving other empty.
+        // Both trees are rebuilt into one balanced tree in O(n + m), unless other is small enough for inserting
+        // its values one by one to be cheaper. The nodes of other are taken over as they are if the
+        // allocators compare equal.
+        void           Merge(BinaryTree<T, Alloc, Balance>& other);
+        // Moves the values that are not less than val into the returned tree, in O(n). Both trees come out
+        // balanced, and only the smaller of the two gets its values moved into new nodes.
+        BinaryTree     Split(const T& val);
+        // A read-only copy of the values laid out in a single array for searching, see FrozenTree.
+        FrozenTree<T, Alloc> Freeze() const;
+        // Hand every value to visit in the given order, without allocating.
+        template <typename F>
+        void           ForEachInOrder(F&& visit) const;
+        template <typename F>
+        void           ForEachPreOrder(F&& visit) const;
+        template <typename F>
+        void           ForEachPostOrder(F&& visit) const;
+
+    public:
+        ConstIterator        begin() const noexcept { return ConstIterator(this, Leftmost(m_Root)); }
+        ConstIterator        end() const noexcept { return ConstIterator(this, nullptr); }
+        ConstIterator        cbegin() const noexcept { return begin(); }
+        ConstIterator        cend() const noexcept { return end(); }
+        ConstReverseIterator rbegin() const noexcept { return ConstReverseIterator(end()); }
+        ConstReverseIterator rend() const noexcept { return ConstReverseIterator(begin()); }
     };
 } // namespace my
 
+namespace my {
+    template <typename T, typename Alloc = Allocator<T>>
+    using AVLTree = BinaryTree<T, Alloc, AVLBalance>;
+
+    template <typename T, typename Alloc = Allocator<T>>
+    using RedBlackTree = BinaryTree<T, Alloc, RedBlackBalance>;
+} // namespace my
+
+namespace my::pmr {
+    template <typename T, IsBalancePolicy Balance = NoBalance>
+    using BinaryTree = my::BinaryTree<T, std::pmr::polymorphic_allocator<T>, Balance>;
+} // namespace my::pmr
+
 #include "BinaryTree.hpp"
 
 #endif // MY_BINARY_TREE_H
@@ -1,57 +1,56 @@
 #ifndef MY_BINARY_TREE_IMPL_H
 #define MY_BINARY_TREE_IMPL_H
 
-#include <functional>
+#include <algorithm>
+#include <bit>
 #include <queue>
 #include <type_traits>
+#include <utility>
 
 namespace my {
-    template <typename T>
-    BinaryTree<T>::Node::Node() = default;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::Node::Node() = default;
 
-    template <typename T>
-    BinaryTree<T>::Node::Node(const T& val) : val(val)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::Node::Node(const T& val) : val(val)
     {
     }
 
-    template <typename T>
-    BinaryTree<T>::BinaryTree() = default;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::Node::Node(T&& val) : val(std::move(val))
+    {
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::BinaryTree() = default;
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::BinaryTree(const Alloc& allocator) noexcept : m_Pool(allocator)
+    {
+    }
 
-    template <typename T>
-    BinaryTree<T>::BinaryTree(const std::initializer_list<T> list)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::BinaryTree(const std::initializer_list<T> list, const Alloc& allocator)
+        : m_Pool(allocator)
     {
         for (const auto& ref : list)
             Insert(ref);
     }
 
-    template <typename T>
-    BinaryTree<T>::BinaryTree(const BinaryTree<T>& other)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::BinaryTree(const BinaryTree<T, Alloc, Balance>& other)
+        : m_Pool(NodeAllocTraits::select_on_container_copy_construction(other.m_Pool.GetAllocator()))
     {
         if (other.m_Root)
         {
-            // Recursive helper lambda that takes a pointer to the source tree and a pointer reference
-            // to the new tree and simply traverses our source tree and creates a new node
-            // for our destination tree and copies the current value from the source tree
-            // to the destination tree.
-            std::function<void(Node*, Node*&)> recv = [&](Node* ptr, Node*& dest)
-            {
-                // Our current dest pointer is the node to be created so create it and pass
-                // our source tree's current value.
-                dest = new Node(ptr->val);
-
-                // Now continue traversing through the source tree.
-                if (ptr->left)
-                    recv(ptr->left, root->left);
-                if (ptr->right)
-                    recv(ptr->right, root->right);
-            };
-            recv(other.m_Root, m_Root);
+            m_Root  = CloneSubtree<const Node>(other.m_Root, nullptr);
             m_Count = other.m_Count;
         }
     }
 
-    template <typename T>
-    BinaryTree<T>::BinaryTree(BinaryTree<T>&& other) noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::BinaryTree(BinaryTree<T, Alloc, Balance>&& other) noexcept
+        : m_Pool(std::move(other.m_Pool))
     {
         if (other.m_Root)
         {
@@ -62,56 +61,61 @@ namespace my {
         }
     }
 
-    template <typename T>
-    BinaryTree<T>::~BinaryTree()
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>::~BinaryTree()
     {
         Drop(true);
     }
 
-    template <typename T>
-    BinaryTree<T>& BinaryTree<T>::operator=(const BinaryTree<T>& other) const
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>& BinaryTree<T, Alloc, Balance>::operator=(const BinaryTree<T, Alloc, Balance>& other)
     {
         // So we don't try to assign ourselves to ourselves? Yeah...
         if (this == &other)
             return *this;
-        
+
         // In case we have an active tree.
-        if (m_Root)
-            Drop();
+        Drop();
+        if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value)
+            m_Pool.Reset(other.m_Pool.GetAllocator());
 
         // Same as the copy constructor.
         if (other.m_Root)
         {
-            // Recursive helper lambda that captures itself by reference intended for 
-            // recursively copying from root to ptr.
-            std::function<void(Node*, Node*&)> recv = [&recv](Node* ptr, Node*& root)
-            {
-                // Our 'root' or destination tree is a new node that holds our 
-                // source tree's value.
-                root = new Node(ptr->val);
-
-                if (ptr->left)
-                    recv(ptr->left, root->left);
-                if (ptr->right)
-                    recv(ptr->right, root->right);
-            };
-            recv(other.m_Root, m_Root);
+            m_Root  = CloneSubtree<const Node>(other.m_Root, nullptr);
             m_Count = other.m_Count;
         }
 
         return *this;
     }
 
-    template <typename T>
-    BinaryTree<T>& BinaryTree<T>::operator=(BinaryTree<T>&& other) noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance>& BinaryTree<T, Alloc, Balance>::operator=(
+        BinaryTree<T, Alloc, Balance>&& other) noexcept(
+            NodeAllocTraits::propagate_on_container_move_assignment::value || NodeAllocTraits::is_always_equal::value)
     {
         // So we don't try to move ourself.
         if (this == &other)
             return *this;
 
         // Dispose our current tree if there's one.
-        if (m_Root)
-            Drop();
+        Drop();
+
+        if constexpr (!NodeAllocTraits::propagate_on_container_move_assignment::value &&
+                      !NodeAllocTraits::is_always_equal::value)
+        {
+            // The nodes belong to a different memory resource, so the values have to be moved one by one.
+            if (m_Pool.GetAllocator() != other.m_Pool.GetAllocator())
+            {
+                if (other.m_Root)
+                    m_Root = CloneSubtree<Node>(other.m_Root, nullptr);
+                m_Count = other.m_Count;
+                other.Drop();
+                return *this;
+            }
+        }
+
+        m_Pool = std::move(other.m_Pool);
 
         // If other is valid.
         if (other.m_Root)
@@ -125,183 +129,509 @@ namespace my {
         return *this;
     }
 
-    template <typename T>
-    inline void BinaryTree<T>::Drop(const bool destructing)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    inline void BinaryTree<T, Alloc, Balance>::Drop(const bool destructing)
     {
         // Helper function for properly disposing the tree.
 
-        // Recursive helper lambda that simply goes through all the nodes
-        // and calls delete on them.
-        std::function<void(Node*)> recv = [&](Node* ptr)
+        // The nodes only have to be visited if they have a destructor to run, their memory goes back to the
+        // allocator a whole slab at a time.
+        if constexpr (!std::is_trivially_destructible_v<Node>)
         {
-            if (ptr->left)
-                recv(ptr->left);
-            if (ptr->right)
-                recv(ptr->right);
-
-            delete ptr;
-        };
+            // Post-order, so a node is only destroyed once the walk no longer needs its links.
+            PostOrderWalk(m_Root, [](Node* node) { std::destroy_at(node); });
+        }
+        m_Pool.Release();
+        m_Root  = nullptr;
+        m_Count = 0;
+    }
 
-        recv(m_Root);
-        m_Root = nullptr;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename... TArgs>
+    inline typename BinaryTree<T, Alloc, Balance>::Node* BinaryTree<T, Alloc, Balance>::CreateNode(TArgs&&... args)
+    {
+        Node* node = m_Pool.Allocate();
+        try
+        {
+            std::construct_at(node, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            m_Pool.Deallocate(node);
+            throw;
+        }
+        return node;
     }
 
-    template <typename T>
-    void BinaryTree<T>::Insert(const T& val)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    inline void BinaryTree<T, Alloc, Balance>::DestroyNode(Node* node) noexcept
     {
-        // If T is a number, check if it is negative, if so, ignore and move on.
-        if (std::is_arithmetic<T>::value)
-            if (val < 0)
-                return;
+        std::destroy_at(node);
+        m_Pool.Deallocate(node);
+    }
 
-        // If its the first node.
-        if (!m_Root)
-            m_Root = new Node(val);
-        else
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename Src>
+    typename BinaryTree<T, Alloc, Balance>::Node* BinaryTree<T, Alloc, Balance>::CloneSubtree(Src* src, Node* parent)
+    {
+        auto clone = [this](Src* from, Node* to_parent)
         {
-            // If its not the first node then try to insert.
-            auto* current = m_Root;
+            Node* node;
+            if constexpr (std::is_const_v<Src>)
+                node = CreateNode(from->val);
+            else
+                node = CreateNode(std::move(from->val));
+            node->parent = to_parent;
+            node->size   = from->size;
+            node->height = from->height;
+            node->red    = from->red;
+            return node;
+        };
 
-            // If our current node pointer is valid and we do not want to insert an already exsiting value.
-            while (current && current->val != val)
+        // Walks both trees in step, going down into whichever child has not been copied yet and back up once
+        // both have been.
+        Node* root = clone(src, parent);
+        Node* node = root;
+        try
+        {
+            while (true)
             {
-                // If the val is bigger than the current node's val.
-                if (val < current->val)
+                if (src->left && !node->left)
                 {
-                    // If we do not have a left node then this is it, create the node and store our new val.
-                    if (!current->left)
-                    {
-                        current->left = new Node(val);
-                        ++m_Count;
-                        break;
-                    }
-                    else
-                        // Else go left.
-                        current = current->left;
+                    node->left = clone(src->left, node);
+                    src        = src->left;
+                    node       = node->left;
+                }
+                else if (src->right && !node->right)
+                {
+                    node->right = clone(src->right, node);
+                    src         = src->right;
+                    node        = node->right;
                 }
+                else if (node == root)
+                    return root;
                 else
                 {
-                    // If we do not have a right node then this is it, create the node and store out new val.
-                    if (!current->right)
-                    {
-                        current->right = new Node(val);
-                        ++m_Count;
-                        break;
-                    }
-                    else
-                        // Else go right.
-                        current = current->right;
+                    src  = src->parent;
+                    node = node->parent;
                 }
             }
         }
+        catch (...)
+        {
+            // The copies made so far are a proper subtree, so they are torn down like any other nodes.
+            PostOrderWalk(root, [this](Node* copy) { DestroyNode(copy); });
+            throw;
+        }
     }
 
-    template <typename T>
-    void BinaryTree<T>::Remove(const T& val)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::Leftmost(N* node) noexcept
     {
-        bool  found   = false;   // Boolean flag for determining if our value was found or not.
-        auto* current = m_Root;  // Current node pointer.
-        auto* prev    = current; // Previous node pointer.
+        if (node)
+            while (node->left)
+                node = node->left;
+        return node;
+    }
 
-        // Try and find the value.
-        while (current)
-        {
-            // Store current pointer as the previous.
-            prev = current;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::Rightmost(N* node) noexcept
+    {
+        if (node)
+            while (node->right)
+                node = node->right;
+        return node;
+    }
 
-            // Did we find it?
-            if (current->val == val)
-            {
-                // Found it, yay.
-                found = true;
-                break;
-            }
-            // Nope, go left if the value is smaller.
-            else if (current->val > val)
-                current = current->left;
-            else
-                current = current->right; // Else go right.
-        }
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::InOrderNext(N* node) noexcept
+    {
+        // The leftmost node of the right subtree, or else the first ancestor that is reached from a left child.
+        if (node->right)
+            return Leftmost(node->right);
+        while (node->parent && node == node->parent->right)
+            node = node->parent;
+        return node->parent;
+    }
 
-        // In case the value that we want to remove doesn't actually exist in our tree.
-        if (!found)
-            return;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::InOrderPrev(N* node) noexcept
+    {
+        if (node->left)
+            return Rightmost(node->left);
+        while (node->parent && node == node->parent->left)
+            node = node->parent;
+        return node->parent;
+    }
 
-        // If it is the head that we are trying to remove.
-        if (current == m_Root)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::PreOrderNext(N* node) noexcept
+    {
+        // Down into the first child there is, or else back up to the first right subtree not visited yet.
+        if (node->left)
+            return node->left;
+        if (node->right)
+            return node->right;
+        for (; node->parent; node = node->parent)
+            if (node == node->parent->left && node->parent->right)
+                return node->parent->right;
+        return nullptr;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::PostOrderFirst(N* node) noexcept
+    {
+        while (node->left || node->right)
+            node = node->left ? node->left : node->right;
+        return node;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N>
+    N* BinaryTree<T, Alloc, Balance>::PostOrderNext(N* node) noexcept
+    {
+        // A left child is followed by its sibling's subtree, everything else by its parent.
+        N* parent = node->parent;
+        if (parent && node == parent->left && parent->right)
+            return PostOrderFirst(parent->right);
+        return parent;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::ReplaceChild(Node* parent, const Node* node, Node* child) noexcept
+    {
+        if (!parent)
+            m_Root = child;
+        else if (parent->left == node)
+            parent->left = child;
+        else
+            parent->right = child;
+
+        if (child)
+            child->parent = parent;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    typename BinaryTree<T, Alloc, Balance>::Node* BinaryTree<T, Alloc, Balance>::RotateLeft(Node* node) noexcept
+    {
+        // node's right child takes its place and node becomes that child's left child.
+        Node* pivot = node->right;
+        node->right = pivot->left;
+        if (pivot->left)
+            pivot->left->parent = node;
+
+        ReplaceChild(node->parent, node, pivot);
+        pivot->left  = node;
+        node->parent = pivot;
+        UpdateSize(node);
+        UpdateSize(pivot);
+
+        if constexpr (std::is_same_v<Balance, AVLBalance>)
+        {
+            UpdateHeight(node);
+            UpdateHeight(pivot);
+        }
+        return pivot;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    typename BinaryTree<T, Alloc, Balance>::Node* BinaryTree<T, Alloc, Balance>::RotateRight(Node* node) noexcept
+    {
+        Node* pivot = node->left;
+        node->left  = pivot->right;
+        if (pivot->right)
+            pivot->right->parent = node;
+
+        ReplaceChild(node->parent, node, pivot);
+        pivot->right = node;
+        node->parent = pivot;
+        UpdateSize(node);
+        UpdateSize(pivot);
+
+        if constexpr (std::is_same_v<Balance, AVLBalance>)
         {
-            // Grab the found node's left pointer and then go all the way to the left
-            // until there's no left node left (pun not intended).
-            auto* current2 = current->right;
-            while (current2->left)
-                current2 = current2->left;
+            UpdateHeight(node);
+            UpdateHeight(pivot);
+        }
+        return pivot;
+    }
 
-            // Assign the root (m_Root) to the leftmost node of the right node (current2) of the to be deleted node
-            // (current).
-            m_Root = current2;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::UpdateHeight(Node* node) noexcept
+    {
+        node->height = u8(1 + std::max(HeightOf(node->left), HeightOf(node->right)));
+    }
 
-            // Assign the new root's left node to be the to be deleted node's right node.
-            m_Root->right = current->right;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::RebalanceAVL(Node* node) noexcept
+    {
+        for (; node; node = node->parent)
+        {
+            UpdateHeight(node);
+            const i32 balance = i32(HeightOf(node->left)) - i32(HeightOf(node->right));
+            if (balance > 1)
+            {
+                // Left heavy, a left-right shape is turned into a left-left one first.
+                if (HeightOf(node->left->left) < HeightOf(node->left->right))
+                    RotateLeft(node->left);
+                node = RotateRight(node);
+            }
+            else if (balance < -1)
+            {
+                if (HeightOf(node->right->right) < HeightOf(node->right->left))
+                    RotateRight(node->right);
+                node = RotateLeft(node);
+            }
+        }
+    }
 
-            // And finally delete it.
-            delete current;
-            return;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::InsertFixupRedBlack(Node* node) noexcept
+    {
+        // node is red, the only rule that can be broken is that of a red node with a red parent. The root is
+        // black, so a red parent always has a parent of its own.
+        while (IsRed(node->parent))
+        {
+            Node* parent      = node->parent;
+            Node* grandparent = parent->parent;
+            if (parent == grandparent->left)
+            {
+                Node* uncle = grandparent->right;
+                if (IsRed(uncle))
+                {
+                    // Push the red up and carry on from the grandparent.
+                    parent->red      = false;
+                    uncle->red       = false;
+                    grandparent->red = true;
+                    node             = grandparent;
+                    continue;
+                }
+                if (node == parent->right)
+                {
+                    RotateLeft(parent);
+                    std::swap(node, parent);
+                }
+                parent->red      = false;
+                grandparent->red = true;
+                RotateRight(grandparent);
+            }
+            else
+            {
+                Node* uncle = grandparent->left;
+                if (IsRed(uncle))
+                {
+                    parent->red      = false;
+                    uncle->red       = false;
+                    grandparent->red = true;
+                    node             = grandparent;
+                    continue;
+                }
+                if (node == parent->left)
+                {
+                    RotateRight(parent);
+                    std::swap(node, parent);
+                }
+                parent->red      = false;
+                grandparent->red = true;
+                RotateLeft(grandparent);
+            }
         }
+        m_Root->red = false;
+    }
 
-        // If it is not the root and our node doesn't have a right node.
-        if (!current->right)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::RemoveFixupRedBlack(Node* node, Node* parent) noexcept
+    {
+        // Every path through node is one black node short. Either node can be made black, or the shortage is
+        // moved up the tree or fixed by borrowing from the sibling's side.
+        while (node != m_Root && !IsRed(node))
         {
-            // See if it has a left pointer.
-            if (current->left)
+            if (node == parent->left)
             {
-                if (prev->left == current)
-                    prev->left = current->left;
-                else
-                    prev->right = current->right;
+                Node* sibling = parent->right;
+                if (IsRed(sibling))
+                {
+                    sibling->red = false;
+                    parent->red  = true;
+                    RotateLeft(parent);
+                    sibling = parent->right;
+                }
+                if (!IsRed(sibling->left) && !IsRed(sibling->right))
+                {
+                    sibling->red = true;
+                    node         = parent;
+                    parent       = node->parent;
+                    continue;
+                }
+                if (!IsRed(sibling->right))
+                {
+                    sibling->left->red = false;
+                    sibling->red       = true;
+                    RotateRight(sibling);
+                    sibling = parent->right;
+                }
+                sibling->red        = parent->red;
+                parent->red         = false;
+                sibling->right->red = false;
+                RotateLeft(parent);
+                node = m_Root;
+            }
+            else
+            {
+                Node* sibling = parent->left;
+                if (IsRed(sibling))
+                {
+                    sibling->red = false;
+                    parent->red  = true;
+                    RotateRight(parent);
+                    sibling = parent->left;
+                }
+                if (!IsRed(sibling->left) && !IsRed(sibling->right))
+                {
+                    sibling->red = true;
+                    node         = parent;
+                    parent       = node->parent;
+                    continue;
+                }
+                if (!IsRed(sibling->left))
+                {
+                    sibling->right->red = false;
+                    sibling->red        = true;
+                    RotateLeft(sibling);
+                    sibling = parent->left;
+                }
+                sibling->red       = parent->red;
+                parent->red        = false;
+                sibling->left->red = false;
+                RotateRight(parent);
+                node = m_Root;
+            }
+        }
+        if (node)
+            node->red = false;
+    }
 
-                delete current;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::Insert(const T& val)
+    {
+        // If T is a number, check if it is negative, if so, ignore and move on.
+        if constexpr (std::is_arithmetic<T>::value)
+            if (val < 0)
                 return;
-            }
-            else // If it doesn't then it's a leaf, easy peasy.
+
+        // Walk down to where the value belongs, keeping hold of the link to fill in. Every subtree passed on
+        // the way gains the new node, the sizes are bumped while the nodes are at hand.
+        Node*  parent = nullptr;
+        Node** link   = &m_Root;
+        while (*link)
+        {
+            parent = *link;
+
+            // We do not want to insert an already existing value.
+            if (parent->val == val)
             {
-                // If to be deleted node is previous' left node,
-                // then assign it to nullptr.
-                if (prev->left == current)
-                    prev->left = nullptr;
-                else // Else it's the right.
-                    prev->right = nullptr;
-
-                // Finally, delete it.
-                delete current;
+                for (Node* ancestor = parent->parent; ancestor; ancestor = ancestor->parent)
+                    --ancestor->size;
                 return;
             }
+            ++parent->size;
+            link = val < parent->val ? &parent->left : &parent->right;
         }
-        else
-        {
-            // If we do have a right node then assign it to current2 and then
-            // go left as much as we can until we are at the leftmost node.
-            auto* current2 = current->right;
-            while (current2->left)
-                current2 = current2->left;
 
-            // If to be deleted node is previous' left node,
-            // then assign previous' left to point to our leftmost node (current2).
-            if (prev->left == current)
-                prev->left = current2;
-            else // Else it's the right.
-                prev->right = current2;
+        Node* node = nullptr;
+        try
+        {
+            node = CreateNode(val);
+        }
+        catch (...)
+        {
+            for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent)
+                --ancestor->size;
+            throw;
+        }
+        node->parent = parent;
+        *link        = node;
+        ++m_Count;
+
+        if constexpr (std::is_same_v<Balance, AVLBalance>)
+            RebalanceAVL(parent);
+        else if constexpr (std::is_same_v<Balance, RedBlackBalance>)
+            InsertFixupRedBlack(node);
+    }
 
-            // Assign our leftmost node's left to point to our to be deleted node's right.
-            current2->left = current->right;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::Remove(const T& val)
+    {
+        // Try and find the value.
+        Node* current = m_Root;
+        while (current && current->val != val)
+            current = current->val > val ? current->left : current->right;
 
-            // Finally, delete it.
-            delete current;
+        // In case the value that we want to remove doesn't actually exist in our tree.
+        if (!current)
             return;
+
+        // With two children the node's in-order successor, the leftmost node of its right subtree, is unlinked
+        // instead and takes the node's place. Either way child moves up into the unlinked node's spot below
+        // parent, which is where the rebalancing starts from.
+        Node* child;
+        Node* parent;
+        bool  removed_red = current->red;
+        if (!current->left || !current->right)
+        {
+            child  = current->left ? current->left : current->right;
+            parent = current->parent;
+            ReplaceChild(parent, current, child);
+        }
+        else
+        {
+            Node* successor = current->right;
+            while (successor->left)
+                successor = successor->left;
+
+            removed_red = successor->red;
+            child       = successor->right;
+            if (successor->parent == current)
+                parent = successor;
+            else
+            {
+                parent = successor->parent;
+                ReplaceChild(parent, successor, child);
+                successor->right         = current->right;
+                successor->right->parent = successor;
+            }
+            ReplaceChild(current->parent, current, successor);
+            successor->left         = current->left;
+            successor->left->parent = successor;
+            successor->size         = current->size;
+            successor->height       = current->height;
+            successor->red          = current->red;
+        }
+
+        DestroyNode(current);
+        --m_Count;
+        // Every subtree from the unlinked spot up to the root lost a node, the successor took over the size
+        // of the node it replaced so it is counted in too. This waits until the value is known to be there.
+        for (Node* ancestor = parent; ancestor; ancestor = ancestor->parent)
+            --ancestor->size;
+
+        if constexpr (std::is_same_v<Balance, AVLBalance>)
+            RebalanceAVL(parent);
+        else if constexpr (std::is_same_v<Balance, RedBlackBalance>)
+        {
+            if (!removed_red)
+                RemoveFixupRedBlack(child, parent);
         }
     }
 
-    template <typename T>
-    bool BinaryTree<T>::Search(const T& val) const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    bool BinaryTree<T, Alloc, Balance>::Search(const T& val) const noexcept
     {
         // Our current node pointer.
         auto* current = m_Root;
@@ -323,75 +653,31 @@ namespace my {
         return false;
     }
 
-    template <typename T>
-    std::vector<T> BinaryTree<T>::InOrder() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<T> BinaryTree<T, Alloc, Balance>::InOrder() const noexcept
     {
-        // Our vector which will hold our traversed elements.
         std::vector<T> vec;
-
-        // Recurisve helper lambda which will traverse through the tree that captures itself and vec
-        // and takes a Node pointer.
-        std::function<void(Node*)> recv = [&vec, &recv](Node* ptr)
-        {
-            // If there's a right then traverse to the leftmost node.
-            if (ptr->left)
-                recv(ptr->left);
-
-            // Push our value, at this point we are the left most node
-            // which will automatically give us our desired behaviour meaning
-            // our left most node will always be pushed first.
-            vec.push_back(ptr->val);
-
-            // If there's a right node then traverse to the rightmost node.
-            if (ptr->right)
-                recv(ptr->right);
-        };
-
-        // Optimization
         vec.reserve(m_Count);
-
-        recv(m_Root);
+        ForEachInOrder([&vec](const T& val) { vec.push_back(val); });
         return vec;
     }
 
-    template <typename T>
-    std::vector<T> BinaryTree<T>::PostOrder() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<T> BinaryTree<T, Alloc, Balance>::PostOrder() const noexcept
     {
-        // Our vector which will hold our traversed elements.
         std::vector<T> vec;
-
-        // Recurisve helper lambda which will traverse through the tree that captures itself and vec
-        // and takes a Node pointer.
-        std::function<void(Node*)> recv = [&vec, &recv](Node* ptr)
-        {
-            // If there's a right then traverse to the leftmost node.
-            if (ptr->left)
-                recv(ptr->left);
-
-            // Push our value, at this point we are the left most node
-            // which will automatically give us our desired behaviour meaning
-            // our left most node will always be pushed first.
-            if (ptr->right)
-                recv(ptr->right);
-
-            // Push our value, at this point we are the left most node
-            // which will automatically give us our desired behaviour.
-            vec.push_back(ptr->val);
-        };
-
-        // Optimization
         vec.reserve(m_Count);
-
-        recv(m_Root);
+        ForEachPostOrder([&vec](const T& val) { vec.push_back(val); });
         return vec;
     }
 
-    template <typename T>
-    std::vector<T> BinaryTree<T>::LevelOrder() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<T> BinaryTree<T, Alloc, Balance>::LevelOrder() const noexcept
     {
-        std::vector<T>    vec;
-        std::queue<Node*> queue;
-        queue.push(m_Root);
+        std::vector<T>          vec;
+        std::queue<const Node*> queue;
+        if (m_Root)
+            queue.push(m_Root);
         while (!queue.empty())
         {
             auto* current = queue.front();
@@ -405,28 +691,116 @@ namespace my {
         return vec;
     }
 
-    template <typename T>
-    std::vector<T> BinaryTree<T>::PreOrder() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<T> BinaryTree<T, Alloc, Balance>::PreOrder() const noexcept
+    {
+        std::vector<T> vec;
+        vec.reserve(m_Count);
+        ForEachPreOrder([&vec](const T& val) { vec.push_back(val); });
+        return vec;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename F>
+    void BinaryTree<T, Alloc, Balance>::ForEachInOrder(F&& visit) const
     {
-        std::vector<T>             vec;
-        std::function<void(Node*)> recv = [&recv](Node* ptr)
+        // The stack holds the nodes we went left from, they come next once their left subtree is done.
+        const Node* stack[StackDepth];
+        usize       top  = 0;
+        const Node* node = m_Root;
+        while (node || top != 0)
         {
-            vec.push_back(ptr->val);
+            for (; node; node = node->left)
+            {
+                if (top == StackDepth)
+                {
+                    for (node = Leftmost(node); node; node = InOrderNext(node))
+                        visit(node->val);
+                    return;
+                }
+                stack[top++] = node;
+            }
+            node = stack[--top];
+            visit(node->val);
+            node = node->right;
+        }
+    }
 
-            if (ptr->left)
-                recv(ptr->left);
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename F>
+    void BinaryTree<T, Alloc, Balance>::ForEachPreOrder(F&& visit) const
+    {
+        // The stack holds the right subtrees that are left for after the left ones.
+        const Node* stack[StackDepth];
+        usize       top  = 0;
+        const Node* node = m_Root;
+        while (node)
+        {
+            visit(node->val);
+            if (node->left && node->right)
+            {
+                if (top == StackDepth)
+                {
+                    for (node = PreOrderNext(node); node; node = PreOrderNext(node))
+                        visit(node->val);
+                    return;
+                }
+                stack[top++] = node->right;
+            }
 
-            if (ptr->right)
-                recv(ptr->right);
-        };
+            if (node->left || node->right)
+                node = node->left ? node->left : node->right;
+            else
+                node = top != 0 ? stack[--top] : nullptr;
+        }
+    }
 
-        vec.reserve(m_Count);
-        recv(m_Root);
-        return vec;
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename F>
+    void BinaryTree<T, Alloc, Balance>::ForEachPostOrder(F&& visit) const
+    {
+        PostOrderWalk<const Node>(m_Root, [&visit](const Node* node) { visit(node->val); });
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename N, typename F>
+    void BinaryTree<T, Alloc, Balance>::PostOrderWalk(N* root, F&& visit)
+    {
+        // The stack holds the path down to node, a node is visited once the walk is back from its right child,
+        // which is what last tells.
+        N*    stack[StackDepth];
+        usize top  = 0;
+        N*    node = root;
+        N*    last = nullptr;
+        while (node || top != 0)
+        {
+            if (node)
+            {
+                if (top == StackDepth)
+                {
+                    for (node = PostOrderFirst(node); node;)
+                    {
+                        N* next = PostOrderNext(node);
+                        visit(node);
+                        node = next;
+                    }
+                    return;
+                }
+                stack[top++] = node;
+                node         = node->left;
+            }
+            else if (stack[top - 1]->right && stack[top - 1]->right != last)
+                node = stack[top - 1]->right;
+            else
+            {
+                last = stack[--top];
+                visit(last);
+            }
+        }
     }
 
-    template <typename T>
-    T BinaryTree<T>::FindMax() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    T BinaryTree<T, Alloc, Balance>::FindMax() const noexcept
     {
         auto* current = m_Root;
         while (current->right)
@@ -434,8 +808,8 @@ namespace my {
         return current->val;
     }
 
-    template <typename T>
-    T BinaryTree<T>::FindMin() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    T BinaryTree<T, Alloc, Balance>::FindMin() const noexcept
     {
         auto* current = m_Root;
         while (current->left)
@@ -443,41 +817,69 @@ namespace my {
         return current->val;
     }
 
-    template <typename T>
-    usize BinaryTree<T>::Height() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    usize BinaryTree<T, Alloc, Balance>::Height() const noexcept
     {
-        // Our current height holder.
-        usize                      height = 0;
-
-        // Maximum value height reached which is our actual height really.
-        usize                      max    = 0;
-
-        // Recursive lambda that will traverse through each node, increment 
-        std::function<void(Node*)> recv   = [&recv](Node* ptr)
+        // AVL trees keep it up to date anyway.
+        if constexpr (std::is_same_v<Balance, AVLBalance>)
+            return HeightOf(m_Root);
+        else
         {
-            ++height;
-            if (ptr->left)
-                recv(ptr->left);
-            if (ptr->right)
-                recv(ptr->right);
+            // A pre-order walk over (node, depth) pairs.
+            std::pair<const Node*, usize> stack[StackDepth];
+            usize                         top = 0;
+            usize                         max = 0;
+            if (m_Root)
+                stack[top++] = { m_Root, 1 };
+            while (top != 0)
+            {
+                const auto [node, depth] = stack[--top];
+                max                      = std::max(max, depth);
+                if (top + 2 > StackDepth)
+                    return HeightByParents();
+                if (node->right)
+                    stack[top++] = { node->right, depth + 1 };
+                if (node->left)
+                    stack[top++] = { node->left, depth + 1 };
+            }
+            return max;
+        }
+    }
 
-            if (max < height)
-                max = height;
-            --height;
-        };
-        recv(m_Root);
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    usize BinaryTree<T, Alloc, Balance>::HeightByParents() const noexcept
+    {
+        // A pre-order walk that keeps track of the depth as it goes down and back up.
+        usize max   = 0;
+        usize depth = 1;
+        for (const Node* node = m_Root; node;)
+        {
+            max = std::max(max, depth);
+            if (node->left || node->right)
+            {
+                node = node->left ? node->left : node->right;
+                ++depth;
+                continue;
+            }
+            while (node->parent && !(node == node->parent->left && node->parent->right))
+            {
+                node = node->parent;
+                --depth;
+            }
+            node = node->parent ? node->parent->right : nullptr;
+        }
         return max;
     }
 
-    template <typename T>
-    std::vector<T> BinaryTree<T>::Serialize() const noexcept
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<T> BinaryTree<T, Alloc, Balance>::Serialize() const noexcept
     {
         // Serialize is InOrder in disguise.
         return InOrder();
     }
 
-    template <typename T>
-    const T& BinaryTree<T>::Successor(const T& val) const
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    const T& BinaryTree<T, Alloc, Balance>::Successor(const T& val) const
     {
         // Our current node pointer.
         auto* current  = m_Root;
@@ -495,8 +897,11 @@ namespace my {
                     return current->val;
                 else if (!current->right) // Else if there's no left node then return the ancestor.
                     return ancestor->val;
-                else 
-                    return current->right->val; // Else just return the current's right node's value.
+                // Else it's the leftmost node of the right subtree.
+                current = current->right;
+                while (current->left)
+                    current = current->left;
+                return current->val;
             }
             else if (current->val > val) // If the current value is bigger than the provided value then our ancestor becomes the current node.
 
@@ -513,8 +918,8 @@ namespace my {
         throw std::invalid_argument("Value does not exist.");
     }
 
-    template <typename T>
-    const T& BinaryTree<T>::Predecessor(const T& val) const
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    const T& BinaryTree<T, Alloc, Balance>::Predecessor(const T& val) const
     {
         // Our current node pointer.
         auto* current  = m_Root;
@@ -532,8 +937,11 @@ namespace my {
                     return current->val;
                 else if (!current->left) // Else if there's no left node then return the ancestor.
                     return ancestor->val;
-                else
-                    return current->left->val; // Else just return the current's left node's value.
+                // Else it's the rightmost node of the left subtree.
+                current = current->left;
+                while (current->right)
+                    current = current->right;
+                return current->val;
             }
             else if (current->val < val) // If the current value is lesser than the provided value then our ancestor becomes the current node.
                 ancestor = current;
@@ -549,46 +957,308 @@ namespace my {
         throw std::invalid_argument("Value does not exist.");
     }
 
-    template <typename T>
-    std::vector<T> BinaryTree<T>::RangeQuery(const T& begin, const T& end) const
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<T> BinaryTree<T, Alloc, Balance>::RangeQuery(const T& begin, const T& end) const
     {
         // If begin is bigger than end then return an empty vector.
         if (begin > end)
             return {};
 
-        std::vector<T>                   vec;
+        // Everything strictly between begin and end, in order.
+        std::vector<T> vec;
+        for (auto it = UpperBound(begin); it != this->end() && *it < end; ++it)
+            vec.emplace_back(*it);
+        return vec;
+    }
 
-        // Recursive helper lambda that captures itself as a reference and vec as a reference
-        // and grabs all the value that fall in the range of begin and end and pushes them into vec.
-        const std::function<void(Node*)> recv = [&recv, &vec](Node* ptr)
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    typename BinaryTree<T, Alloc, Balance>::ConstIterator BinaryTree<T, Alloc, Balance>::LowerBound(
+        const T& val) const noexcept
+    {
+        // The last node we went left at is the smallest value seen so far that is not less than val.
+        const Node* bound = nullptr;
+        for (const Node* current = m_Root; current;)
         {
-            // If our current value is bigger than begin and lesser than end
-            // then push it and continue traversing.
-            if (ptr->val > begin && ptr->val < end)
+            if (current->val < val)
+                current = current->right;
+            else
             {
-                vec.emplace_back(ptr->val);
-                if (ptr->left)
-                    recv(ptr->left);
-                if (ptr->right)
-                    recv(ptr->right);
+                bound   = current;
+                current = current->left;
             }
-            else // Else if it does not fall in the range.
+        }
+        return ConstIterator(this, bound);
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    typename BinaryTree<T, Alloc, Balance>::ConstIterator BinaryTree<T, Alloc, Balance>::UpperBound(
+        const T& val) const noexcept
+    {
+        const Node* bound = nullptr;
+        for (const Node* current = m_Root; current;)
+        {
+            if (val < current->val)
             {
-                // If our val is lesser than begin then go right.
-                if (ptr->val < begin)
-                {
-                    if (ptr->right)
-                        recv(ptr->right);
-                }
-                else if (ptr->val > end) // Else if it is bigger than end then go left.
-                {
-                    if (ptr->left)
-                        recv(ptr->left);
-                }
+                bound   = current;
+                current = current->left;
             }
-        };
-        recv(m_Root);
-        return vec;
+            else
+                current = current->right;
+        }
+        return ConstIterator(this, bound);
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <bool Inclusive>
+    usize BinaryTree<T, Alloc, Balance>::CountBefore(const T& val) const noexcept
+    {
+        // Every time the walk goes right, the node and its whole left subtree come before val.
+        usize count = 0;
+        for (const Node* current = m_Root; current;)
+        {
+            if (Inclusive ? !(val < current->val) : current->val < val)
+            {
+                count += SizeOf(current->left) + 1;
+                current = current->right;
+            }
+            else
+                current = current->left;
+        }
+        return count;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    usize BinaryTree<T, Alloc, Balance>::Rank(const T& val) const noexcept
+    {
+        return CountBefore<false>(val);
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    const T& BinaryTree<T, Alloc, Balance>::Select(usize k) const
+    {
+        if (k >= m_Count)
+            throw std::out_of_range("Tried calling Select() with a rank past the end of the tree.");
+
+        // k counts the values still to skip inside the current subtree.
+        const Node* current = m_Root;
+        while (true)
+        {
+            const usize left = SizeOf(current->left);
+            if (k == left)
+                return current->val;
+            if (k < left)
+                current = current->left;
+            else
+            {
+                k -= left + 1;
+                current = current->right;
+            }
+        }
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    usize BinaryTree<T, Alloc, Balance>::CountRange(const T& begin, const T& end) const noexcept
+    {
+        if (!(begin < end))
+            return 0;
+        return CountBefore<false>(end) - CountBefore<true>(begin);
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    std::vector<typename BinaryTree<T, Alloc, Balance>::Node*> BinaryTree<T, Alloc, Balance>::CollectNodes() const
+    {
+        std::vector<Node*> nodes;
+        nodes.reserve(m_Count);
+        for (Node* node = Leftmost(m_Root); node; node = InOrderNext(node))
+            nodes.push_back(node);
+        return nodes;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename F>
+    void BinaryTree<T, Alloc, Balance>::LinkBalanced(Node*& link, Node* parent, const usize first, const usize count,
+                                                     const usize depth, const usize red_depth, F& at)
+    {
+        // The middle node goes on top, the left half gets the extra node when count is even. The recursion only
+        // goes as deep as the tree it builds, which is logarithmic.
+        const usize left  = count / 2;
+        const usize right = count - left - 1;
+        Node*       node  = at(first + left);
+        node->left        = nullptr;
+        node->right       = nullptr;
+        node->parent      = parent;
+        link              = node;
+
+        if (left)
+            LinkBalanced(node->left, node, first, left, depth + 1, red_depth, at);
+        if (right)
+            LinkBalanced(node->right, node, first + left + 1, right, depth + 1, red_depth, at);
+
+        node->size   = count;
+        node->height = u8(std::bit_width(count));
+        node->red    = depth == red_depth;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    template <typename F>
+    void BinaryTree<T, Alloc, Balance>::BuildBalanced(const usize count, F&& at)
+    {
+        if (count == 0)
+            return;
+
+        LinkBalanced(m_Root, nullptr, 0, count, 0, usize(std::bit_width(count) - 1), at);
+        m_Root->red = false;
+        m_Count     = count;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::Rehome(std::vector<Node*>& nodes, const usize first, const usize last,
+                                               BinaryTree& from)
+    {
+        // Values are only moved if that cannot throw, so moving them back on failure cannot either.
+        std::vector<Node*> fresh;
+        fresh.reserve(last - first);
+        try
+        {
+            for (usize i = first; i < last; ++i)
+                fresh.push_back(CreateNode(std::move_if_noexcept(nodes[i]->val)));
+        }
+        catch (...)
+        {
+            for (usize i = 0; i < fresh.size(); ++i)
+            {
+                if constexpr (std::is_nothrow_move_constructible_v<T>)
+                    nodes[first + i]->val = std::move(fresh[i]->val);
+                DestroyNode(fresh[i]);
+            }
+            throw;
+        }
+
+        for (usize i = first; i < last; ++i)
+        {
+            from.DestroyNode(nodes[i]);
+            nodes[i] = fresh[i - first];
+        }
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::BuildFromSorted(const std::span<const T> values)
+    {
+        const auto out_of_order = [](const T& lhv, const T& rhv) { return !(lhv < rhv); };
+        if (std::adjacent_find(values.begin(), values.end(), out_of_order) != values.end())
+            throw std::invalid_argument("Values are not in strictly ascending order.");
+
+        // Insert() skips negative numbers, in sorted input those are all up front.
+        const T* data  = values.data();
+        usize    count = values.size();
+        if constexpr (std::is_arithmetic<T>::value)
+        {
+            const usize negative = usize(std::lower_bound(values.begin(), values.end(), T(0)) - values.begin());
+            data += negative;
+            count -= negative;
+        }
+
+        // Built off to the side so that the tree stays as it was if a node cannot be created.
+        BinaryTree<T, Alloc, Balance> tree(GetAllocator());
+        tree.BuildBalanced(count, [&tree, data](const usize index) { return tree.CreateNode(data[index]); });
+        *this = std::move(tree);
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    void BinaryTree<T, Alloc, Balance>::Merge(BinaryTree<T, Alloc, Balance>& other)
+    {
+        if (this == &other || !other.m_Root)
+            return;
+
+        // Inserting m values one by one costs m log(n + m), rebuilding n + m.
+        const usize total = m_Count + other.m_Count;
+        if (other.m_Count * usize(std::bit_width(total)) < m_Count)
+        {
+            other.ForEachInOrder([this](const T& val) { Insert(val); });
+            other.Drop();
+            return;
+        }
+
+        std::vector<Node*> mine   = CollectNodes();
+        std::vector<Node*> theirs = other.CollectNodes();
+        std::vector<Node*> merged;
+        merged.reserve(total);
+
+        // Taking over a pool that is mostly unused slots would keep them alive, moving the values costs less.
+        bool shared = other.m_Pool.IsDense(other.m_Count);
+        if constexpr (!NodeAllocTraits::is_always_equal::value)
+            shared = shared && m_Pool.GetAllocator() == other.m_Pool.GetAllocator();
+        if (shared)
+            m_Pool.Splice(other.m_Pool);
+        else
+            Rehome(theirs, 0, theirs.size(), other);
+        // Nothing throws past this point, the nodes of other all belong to this tree now.
+        other.m_Root = nullptr;
+        other.Drop();
+
+        usize i = 0, j = 0;
+        while (i < mine.size() && j < theirs.size())
+        {
+            if (mine[i]->val < theirs[j]->val)
+                merged.push_back(mine[i++]);
+            else if (theirs[j]->val < mine[i]->val)
+                merged.push_back(theirs[j++]);
+            else
+                DestroyNode(theirs[j++]);
+        }
+        merged.insert(merged.end(), mine.begin() + ptrdiff(i), mine.end());
+        merged.insert(merged.end(), theirs.begin() + ptrdiff(j), theirs.end());
+
+        m_Root = nullptr;
+        BuildBalanced(merged.size(), [&merged](const usize index) { return merged[index]; });
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    BinaryTree<T, Alloc, Balance> BinaryTree<T, Alloc, Balance>::Split(const T& val)
+    {
+        BinaryTree<T, Alloc, Balance> upper(GetAllocator());
+        if (!m_Root)
+            return upper;
+
+        std::vector<Node*> nodes = CollectNodes();
+        const usize        split = usize(
+            std::partition_point(nodes.begin(), nodes.end(), [&val](const Node* node) { return node->val < val; }) -
+            nodes.begin());
+        const usize count = nodes.size();
+        if (split == count)
+            return upper;
+
+        // The pool stays with whichever side is larger, the other side moves its values into new nodes.
+        if (count - split <= split)
+            upper.Rehome(nodes, split, count, *this);
+        else
+        {
+            m_Pool.Swap(upper.m_Pool);
+            try
+            {
+                Rehome(nodes, 0, split, upper);
+            }
+            catch (...)
+            {
+                m_Pool.Swap(upper.m_Pool);
+                throw;
+            }
+        }
+
+        m_Root  = nullptr;
+        m_Count = 0;
+        BuildBalanced(split, [&nodes](const usize index) { return nodes[index]; });
+        upper.BuildBalanced(count - split, [&nodes, split](const usize index) { return nodes[split + index]; });
+        return upper;
+    }
+
+    template <typename T, typename Alloc, IsBalancePolicy Balance>
+    FrozenTree<T, Alloc> BinaryTree<T, Alloc, Balance>::Freeze() const
+    {
+        Vec<T, DefaultGrowth, Alloc> sorted(GetAllocator());
+        sorted.Reserve(m_Count);
+        ForEachInOrder([&sorted](const T& val) { sorted.Push(val); });
+        return FrozenTree<T, Alloc>(std::move(sorted));
     }
 } // namespace my
 
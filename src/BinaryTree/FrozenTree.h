@@ -0,0 +1,158 @@
+#ifndef MY_FROZEN_TREE_H
+#define MY_FROZEN_TREE_H
+
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+
+#include <CommonDef.h>
+
+#include "../FlatMap/FlatLayout.h"
+#include "../Memory/Allocator.h"
+#include "../Vector/Vector.h"
+
+namespace my {
+    // A read-only snapshot of a BinaryTree, see BinaryTree::Freeze(). The values sit in a single array in
+    // Eytzinger order (see FlatLayout.h), the implicit tree a search walks down has no pointers to chase, is
+    // searched without branching on the values and prefetches the levels below. Each value takes sizeof(T)
+    // instead of a whole node.
+    template <typename T, typename Alloc = Allocator<T>>
+    class FrozenTree
+    {
+    private:
+        using Layout   = EytzingerLayout;
+        using ValueVec = Vec<T, DefaultGrowth, Alloc>;
+
+    public:
+        // Walks the values in order.
+        class ConstIterator
+        {
+            friend class FrozenTree;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type   = ptrdiff;
+            using value_type        = T;
+            using pointer           = const T*;
+            using reference         = const T&;
+
+        private:
+            const T* m_Values = nullptr;
+            usize    m_Index  = 0;
+            usize    m_Size   = 0;
+
+        private:
+            ConstIterator(const T* values, const usize index, const usize size) noexcept
+                : m_Values(values), m_Index(index), m_Size(size)
+            {
+            }
+
+        public:
+            ConstIterator() noexcept = default;
+
+        public:
+            constexpr reference operator*() const noexcept { return m_Values[m_Index]; }
+            constexpr pointer   operator->() const noexcept { return m_Values + m_Index; }
+            ConstIterator&      operator++() noexcept
+            {
+                m_Index = Layout::Next(m_Index, m_Size);
+                return *this;
+            }
+            ConstIterator operator++(const i32) noexcept
+            {
+                auto t = *this;
+                ++(*this);
+                return t;
+            }
+            ConstIterator& operator--() noexcept
+            {
+                m_Index = m_Index == m_Size ? Layout::Last(m_Size) : Layout::Prev(m_Index, m_Size);
+                return *this;
+            }
+            ConstIterator operator--(const i32) noexcept
+            {
+                auto t = *this;
+                --(*this);
+                return t;
+            }
+
+        public:
+            friend bool operator==(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            {
+                return lhv.m_Values == rhv.m_Values && lhv.m_Index == rhv.m_Index;
+            }
+            friend bool operator!=(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            {
+                return !(lhv == rhv);
+            }
+        };
+        using Iterator = ConstIterator;
+
+    private:
+        ValueVec m_Values;
+
+    public:
+        FrozenTree() = default;
+        explicit FrozenTree(const Alloc& allocator) noexcept;
+        // Takes values that are in strictly ascending order.
+        explicit FrozenTree(ValueVec&& sorted);
+
+    private:
+        // The position of the first value that is not less than val, and of the first one that is greater.
+        usize LowerIndex(const T& val) const noexcept;
+        usize UpperIndex(const T& val) const noexcept;
+
+    public:
+        bool           Search(const T& val) const noexcept;
+        const T&       FindMin() const;
+        const T&       FindMax() const;
+        // The value after and the value before val, or val itself if there is none, like BinaryTree's.
+        const T&       Successor(const T& val) const;
+        const T&       Predecessor(const T& val) const;
+        // The values strictly between begin and end, in order, like BinaryTree::RangeQuery().
+        std::vector<T> RangeQuery(const T& begin, const T& end) const;
+        ConstIterator  LowerBound(const T& val) const noexcept;
+        ConstIterator  UpperBound(const T& val) const noexcept;
+        std::vector<T> InOrder() const;
+        constexpr Alloc GetAllocator() const noexcept { return m_Values.GetAllocator(); }
+
+    public:
+        constexpr usize Size() const noexcept { return m_Values.Size(); }
+        constexpr bool  Empty() const noexcept { return m_Values.Empty(); }
+
+    public:
+        ConstIterator begin() const noexcept { return At(Layout::First(Size())); }
+        ConstIterator end() const noexcept { return At(Size()); }
+        ConstIterator cbegin() const noexcept { return begin(); }
+        ConstIterator cend() const noexcept { return end(); }
+
+    private:
+        ConstIterator At(const usize index) const noexcept { return ConstIterator(m_Values.Data(), index, Size()); }
+
+    public:
+        friend std::ostream& operator<<(std::ostream& stream, const FrozenTree<T, Alloc>& tree)
+        {
+            bool first = true;
+            stream << "{ ";
+            for (const T& val : tree)
+            {
+                if (!first)
+                    stream << ", ";
+                stream << val;
+                first = false;
+            }
+            stream << " }";
+            return stream;
+        }
+    };
+} // namespace my
+
+namespace my::pmr {
+    template <typename T>
+    using FrozenTree = my::FrozenTree<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace my::pmr
+
+#include "FrozenTree.hpp"
+
+#endif // MY_FROZEN_TREE_H
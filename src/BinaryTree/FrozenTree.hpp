@@ -0,0 +1,114 @@
+#ifndef MY_FROZEN_TREE_IMPL_HPP
+#define MY_FROZEN_TREE_IMPL_HPP
+
+#include <stdexcept>
+#include <utility>
+
+#define FROZENTREE_TEMPLATE_DECL() template <typename T, typename Alloc>
+
+namespace my {
+    FROZENTREE_TEMPLATE_DECL()
+    FrozenTree<T, Alloc>::FrozenTree(const Alloc& allocator) noexcept : m_Values(allocator)
+    {
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    FrozenTree<T, Alloc>::FrozenTree(ValueVec&& sorted) : m_Values(ToLayout<Layout>(std::move(sorted)))
+    {
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    usize FrozenTree<T, Alloc>::LowerIndex(const T& val) const noexcept
+    {
+        return Layout::Search(m_Values.Data(), Size(), [&val](const T& element) { return element < val; });
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    usize FrozenTree<T, Alloc>::UpperIndex(const T& val) const noexcept
+    {
+        return Layout::Search(m_Values.Data(), Size(), [&val](const T& element) { return !(val < element); });
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    bool FrozenTree<T, Alloc>::Search(const T& val) const noexcept
+    {
+        const usize index = LowerIndex(val);
+        return index != Size() && !(val < m_Values[index]);
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    const T& FrozenTree<T, Alloc>::FindMin() const
+    {
+        if (Empty())
+            throw std::invalid_argument("It does not exist.");
+        return m_Values[Layout::First(Size())];
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    const T& FrozenTree<T, Alloc>::FindMax() const
+    {
+        if (Empty())
+            throw std::invalid_argument("It does not exist.");
+        return m_Values[Layout::Last(Size())];
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    const T& FrozenTree<T, Alloc>::Successor(const T& val) const
+    {
+        const usize index = LowerIndex(val);
+        if (index == Size() || val < m_Values[index])
+            throw std::invalid_argument("Value does not exist.");
+
+        const usize next = Layout::Next(index, Size());
+        return m_Values[next == Size() ? index : next];
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    const T& FrozenTree<T, Alloc>::Predecessor(const T& val) const
+    {
+        const usize index = LowerIndex(val);
+        if (index == Size() || val < m_Values[index])
+            throw std::invalid_argument("Value does not exist.");
+
+        const usize prev = Layout::Prev(index, Size());
+        return m_Values[prev == Size() ? index : prev];
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    std::vector<T> FrozenTree<T, Alloc>::RangeQuery(const T& begin, const T& end) const
+    {
+        if (begin > end)
+            return {};
+
+        std::vector<T> vec;
+        for (auto it = UpperBound(begin); it != this->end() && *it < end; ++it)
+            vec.emplace_back(*it);
+        return vec;
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    typename FrozenTree<T, Alloc>::ConstIterator FrozenTree<T, Alloc>::LowerBound(const T& val) const noexcept
+    {
+        return At(LowerIndex(val));
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    typename FrozenTree<T, Alloc>::ConstIterator FrozenTree<T, Alloc>::UpperBound(const T& val) const noexcept
+    {
+        return At(UpperIndex(val));
+    }
+
+    FROZENTREE_TEMPLATE_DECL()
+    std::vector<T> FrozenTree<T, Alloc>::InOrder() const
+    {
+        std::vector<T> vec;
+        vec.reserve(Size());
+        for (const T& val : *this)
+            vec.emplace_back(val);
+        return vec;
+    }
+} // namespace my
+
+#undef FROZENTREE_TEMPLATE_DECL
+
+#endif // MY_FROZEN_TREE_IMPL_HPP
@@ -0,0 +1,187 @@
+#ifndef MY_FLAT_LAYOUT_H
+#define MY_FLAT_LAYOUT_H
+
+#include <bit>
+#include <concepts>
+
+#include <CommonDef.h>
+
+#include "../Vector/Vector.h"
+
+namespace my {
+    inline void PrefetchFlat(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    // The order FlatMap and FlatSet keep their elements in. A layout hands out the positions of the elements
+    // in key order through First() and Next(), and backwards through Last() and Prev(), with n standing for
+    // "past the end" either way, and answers partition point searches: Search() returns the position of the
+    // first element for which before(element) is false, or n if there is none. before has to be true for a
+    // prefix of the elements in key order.
+
+    // Plain ascending order searched with a branchless binary search. Positions match ranks, so inserting and
+    // erasing only shifts the tail.
+    struct SortedLayout
+    {
+        static constexpr bool IsSorted = true;
+
+        static constexpr usize First(const usize n) noexcept { return n == 0 ? n : 0; }
+        static constexpr usize Next(const usize index, const usize) noexcept { return index + 1; }
+        static constexpr usize Last(const usize n) noexcept { return n == 0 ? n : n - 1; }
+        static constexpr usize Prev(const usize index, const usize n) noexcept { return index == 0 ? n : index - 1; }
+
+        template <typename T, typename Before>
+        static usize Search(const T* elements, const usize n, Before&& before) noexcept
+        {
+            if (n == 0)
+                return n;
+
+            // The loop always runs log2(n) times and the compiler turns the step into a conditional move.
+            // Both of the places the next step can look at are prefetched, so fetching them overlaps this step.
+            const T* base = elements;
+            for (usize length = n; length > 1;)
+            {
+                const usize half = length / 2;
+                PrefetchFlat(base + half / 2);
+                PrefetchFlat(base + half + half / 2);
+                base += before(base[half]) ? half : 0;
+                length -= half;
+            }
+            return usize(base - elements) + before(*base);
+        }
+    };
+
+    // The elements form an implicit complete binary search tree stored breadth first: the children of
+    // position i sit at 2i + 1 and 2i + 2. The first few levels of every search share the same cache lines,
+    // which makes lookups in large tables noticeably faster than a binary search, at the price of walking the
+    // tree to iterate and of rebuilding the layout on every insertion or erasure.
+    struct EytzingerLayout
+    {
+        static constexpr bool IsSorted = false;
+
+        static constexpr usize First(const usize n) noexcept
+        {
+            if (n == 0)
+                return n;
+            usize index = 0;
+            while (2 * index + 1 < n)
+                index = 2 * index + 1;
+            return index;
+        }
+
+        // The in-order successor, the leftmost node of the right subtree or else the first ancestor that is
+        // reached from a left child.
+        static constexpr usize Next(usize index, const usize n) noexcept
+        {
+            if (2 * index + 2 < n)
+            {
+                index = 2 * index + 2;
+                while (2 * index + 1 < n)
+                    index = 2 * index + 1;
+                return index;
+            }
+            while (index != 0 && index % 2 == 0)
+                index = (index - 1) / 2;
+            return index == 0 ? n : (index - 1) / 2;
+        }
+
+        static constexpr usize Last(const usize n) noexcept
+        {
+            if (n == 0)
+                return n;
+            usize index = 0;
+            while (2 * index + 2 < n)
+                index = 2 * index + 2;
+            return index;
+        }
+
+        // The in-order predecessor, the mirror image of Next().
+        static constexpr usize Prev(usize index, const usize n) noexcept
+        {
+            if (2 * index + 1 < n)
+            {
+                index = 2 * index + 1;
+                while (2 * index + 2 < n)
+                    index = 2 * index + 2;
+                return index;
+            }
+            while (index % 2 == 1)
+                index = (index - 1) / 2;
+            return index == 0 ? n : (index - 1) / 2;
+        }
+
+        template <typename T, typename Before>
+        static usize Search(const T* elements, const usize n, Before&& before) noexcept
+        {
+            // Walks down with one based positions, going right whenever the element comes before the target.
+            // The position of the answer is what is left after dropping the trailing right turns and the
+            // final left one, zero meaning that every element comes before it. The descendants a cache line's
+            // worth of elements further down sit next to each other, the (at most two) lines they span are
+            // fetched ahead of time.
+            constexpr usize Ahead = sizeof(T) < 64 ? std::bit_floor(64 / sizeof(T)) : 1;
+            usize           index = 1;
+            while (index <= n)
+            {
+                // Computed as an integer since the address may lie past the end, prefetching it is harmless.
+                const uintptr ahead = reinterpret_cast<uintptr>(elements) + (index * Ahead - 1) * sizeof(T);
+                PrefetchFlat(reinterpret_cast<const void*>(ahead));
+                PrefetchFlat(reinterpret_cast<const void*>(ahead + (Ahead - 1) * sizeof(T)));
+                index = 2 * index + usize(before(elements[index - 1]));
+            }
+            index >>= std::countr_one(index) + 1;
+            return index == 0 ? n : index - 1;
+        }
+    };
+
+    template <typename T>
+    concept IsFlatLayout = requires(const usize n) {
+        { T::IsSorted } -> std::convertible_to<bool>;
+        { T::First(n) } -> std::convertible_to<usize>;
+        { T::Next(n, n) } -> std::convertible_to<usize>;
+    };
+
+    // Reorders elements that are in key order into the order of Layout, and back. Both depend on nothing but
+    // the element count, so keys and values kept in separate vectors stay paired up.
+    template <IsFlatLayout Layout, typename VecT>
+    VecT ToLayout(VecT&& sorted)
+    {
+        if constexpr (Layout::IsSorted)
+            return std::move(sorted);
+        else
+        {
+            const usize n = sorted.Size();
+            Vec<usize>  rank_at(n);
+            for (usize rank = 0, index = Layout::First(n); rank < n; ++rank, index = Layout::Next(index, n))
+                rank_at[index] = rank;
+
+            VecT arranged(sorted.GetAllocator());
+            arranged.Reserve(n);
+            for (usize index = 0; index < n; ++index)
+                arranged.Push(std::move(sorted[rank_at[index]]));
+            return arranged;
+        }
+    }
+
+    template <IsFlatLayout Layout, typename VecT>
+    VecT ToSorted(VecT&& arranged)
+    {
+        if constexpr (Layout::IsSorted)
+            return std::move(arranged);
+        else
+        {
+            const usize n = arranged.Size();
+            VecT        sorted(arranged.GetAllocator());
+            sorted.Reserve(n);
+            for (usize index = Layout::First(n); index != n; index = Layout::Next(index, n))
+                sorted.Push(std::move(arranged[index]));
+            return sorted;
+        }
+    }
+} // namespace my
+
+#endif // MY_FLAT_LAYOUT_H
@@ -0,0 +1,243 @@
+#ifndef MY_FLAT_MAP_H
+#define MY_FLAT_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include <CommonDef.h>
+
+#include "../HashMap/Utilities/KeyArg.h"
+#include "../HashMap/Utilities/Pair.h"
+#include "../Memory/Allocator.h"
+#include "../Vector/Vector.h"
+#include "FlatLayout.h"
+
+namespace my {
+    // An ordered map that keeps its keys and its values in two my::Vec, one after the other in memory, meant
+    // for tables that are built once and then read a lot. Lookups only ever touch the key array and there are
+    // no nodes or empty slots to pay for. Insert() and Erase() are O(n), bulk construction sorts once.
+    template <typename K, typename V, typename Compare = std::less<>, IsFlatLayout Layout = SortedLayout,
+              typename Alloc = Allocator<Pair<K, V>>>
+    class FlatMap
+    {
+    private:
+        using KeyAllocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<K>;
+        using ValueAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<V>;
+        using KeyVec         = Vec<K, DefaultGrowth, KeyAllocator>;
+        using ValueVec       = Vec<V, DefaultGrowth, ValueAllocator>;
+
+        static constexpr bool IsTransparent = requires { typename Compare::is_transparent; };
+
+        // Lookups accept anything Compare can order against K if it is transparent, like HashMap does.
+        template <typename Q>
+        using KeyArg = typename KeyArgOf<IsTransparent>::template Type<Q, K>;
+
+        // Hands out the elements in key order as a Pair of references, keys are never given out mutably.
+        template <bool Const>
+        class BasicIterator
+        {
+            template <bool>
+            friend class BasicIterator;
+            friend class FlatMap;
+
+            using ValuePointer = std::conditional_t<Const, const V*, V*>;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = ptrdiff;
+            using value_type        = Pair<K, V>;
+            using reference         = Pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+        private:
+            struct ArrowProxy
+            {
+                reference ref;
+
+                const reference* operator->() const noexcept { return &ref; }
+            };
+
+        private:
+            const K*     m_Keys   = nullptr;
+            ValuePointer m_Values = nullptr;
+            usize        m_Index  = 0;
+            usize        m_Size   = 0;
+
+        private:
+            BasicIterator(const K* keys, ValuePointer values, const usize index, const usize size) noexcept
+                : m_Keys(keys), m_Values(values), m_Index(index), m_Size(size)
+            {
+            }
+
+        public:
+            BasicIterator() noexcept = default;
+            template <bool OtherConst>
+                requires(Const && !OtherConst)
+            BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+                : m_Keys(other.m_Keys), m_Values(other.m_Values), m_Index(other.m_Index), m_Size(other.m_Size)
+            {
+            }
+
+        public:
+            reference      operator*() const noexcept { return reference(m_Keys[m_Index], m_Values[m_Index]); }
+            ArrowProxy     operator->() const noexcept { return ArrowProxy{ **this }; }
+            BasicIterator& operator++() noexcept
+            {
+                m_Index = Layout::Next(m_Index, m_Size);
+                return *this;
+            }
+            BasicIterator operator++(const i32) noexcept
+            {
+                auto t = *this;
+                ++(*this);
+                return t;
+            }
+
+        public:
+            friend bool operator==(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
+            {
+                return lhv.m_Keys == rhv.m_Keys && lhv.m_Index == rhv.m_Index;
+            }
+            friend bool operator!=(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
+            {
+                return !(lhv == rhv);
+            }
+        };
+
+    public:
+        using Iterator      = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+
+        // A half open range of elements in key order, valid as long as its iterators are.
+        template <typename It>
+        class View
+        {
+        private:
+            It m_Begin;
+            It m_End;
+
+        public:
+            View(const It begin, const It end) noexcept : m_Begin(begin), m_End(end) {}
+
+        public:
+            constexpr It   begin() const noexcept { return m_Begin; }
+            constexpr It   end() const noexcept { return m_End; }
+            constexpr bool Empty() const noexcept { return m_Begin == m_End; }
+        };
+
+    private:
+        [[no_unique_address]] Compare m_Compare{};
+        KeyVec                        m_Keys;
+        ValueVec                      m_Values;
+
+    public:
+        FlatMap() = default;
+        explicit FlatMap(const Alloc& allocator) noexcept;
+        explicit FlatMap(const Compare& compare, const Alloc& allocator = Alloc());
+        // Takes anything whose elements have a first and a second, when a key shows up more than once the
+        // last of its values wins, the same as inserting them one by one would.
+        template <typename It>
+        FlatMap(It first, It last, const Compare& compare = Compare(), const Alloc& allocator = Alloc());
+        FlatMap(const std::initializer_list<Pair<K, V>> list, const Compare& compare = Compare(),
+                const Alloc& allocator = Alloc());
+
+    private:
+        template <typename Q>
+        usize LowerIndex(const Q& key) const noexcept;
+        template <typename Q>
+        usize UpperIndex(const Q& key) const noexcept;
+        template <typename Q>
+        usize FindIndex(const Q& key) const noexcept;
+        // Where key would go among keys that are in key order.
+        template <typename Q>
+        usize SortedRank(const KeyVec& keys, const Q& key) const noexcept;
+        template <typename KArg, typename VArg>
+        bool  InsertImpl(KArg&& key, VArg&& value);
+
+    public:
+        // Replaces the contents with the pairs of the range, see the range constructor.
+        template <typename It>
+        void                      Assign(It first, It last);
+        // Returns true if the key was already there, in which case its value is overwritten.
+        bool                      Insert(const K& key, const V& value);
+        bool                      Insert(K&& key, V&& value);
+        template <typename Q = K>
+        V*                        Find(const KeyArg<Q>& key) noexcept;
+        template <typename Q = K>
+        const V*                  Find(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        V&                        At(const KeyArg<Q>& key);
+        template <typename Q = K>
+        const V&                  At(const KeyArg<Q>& key) const;
+        template <typename Q = K>
+        bool                      ContainsKey(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        bool                      Erase(const KeyArg<Q>& key);
+        // The first element whose key is not less than key, and the first one whose key is greater.
+        template <typename Q = K>
+        ConstIterator             LowerBound(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        ConstIterator             UpperBound(const KeyArg<Q>& key) const noexcept;
+        // The elements with keys in [low, high) without copying any of them.
+        template <typename Q = K>
+        View<ConstIterator>       Range(const KeyArg<Q>& low, const KeyArg<Q>& high) const noexcept;
+        // The elements with keys strictly between begin and end, in key order, like BinaryTree::RangeQuery().
+        template <typename Q = K>
+        std::vector<Pair<K, V>>   RangeQuery(const KeyArg<Q>& begin, const KeyArg<Q>& end) const;
+        void                      Clear() noexcept;
+        void                      Reserve(const usize count);
+        void                      ShrinkToFit();
+        void                      Swap(FlatMap<K, V, Compare, Layout, Alloc>& other) noexcept;
+        constexpr Alloc           GetAllocator() const noexcept { return Alloc(m_Keys.GetAllocator()); }
+        constexpr Compare         KeyComp() const { return m_Compare; }
+
+    public:
+        constexpr usize Size() const noexcept { return m_Keys.Size(); }
+        constexpr bool  Empty() const noexcept { return m_Keys.Empty(); }
+
+    public:
+        Iterator      begin() noexcept { return MakeIterator<false>(Layout::First(Size())); }
+        Iterator      end() noexcept { return MakeIterator<false>(Size()); }
+        ConstIterator begin() const noexcept { return cbegin(); }
+        ConstIterator end() const noexcept { return cend(); }
+        ConstIterator cbegin() const noexcept { return MakeIterator<true>(Layout::First(Size())); }
+        ConstIterator cend() const noexcept { return MakeIterator<true>(Size()); }
+
+    private:
+        template <bool Const>
+        BasicIterator<Const> MakeIterator(const usize index) const noexcept
+        {
+            return BasicIterator<Const>(m_Keys.Data(), m_Values.Data(), index, Size());
+        }
+
+    public:
+        friend std::ostream& operator<<(std::ostream& stream, const FlatMap<K, V, Compare, Layout, Alloc>& map)
+        {
+            bool first = true;
+            stream << "{ ";
+            for (const auto pair : map)
+            {
+                if (!first)
+                    stream << ", ";
+                stream << pair;
+                first = false;
+            }
+            stream << " }";
+            return stream;
+        }
+    };
+} // namespace my
+
+namespace my::pmr {
+    template <typename K, typename V, typename Compare = std::less<>, IsFlatLayout Layout = SortedLayout>
+    using FlatMap = my::FlatMap<K, V, Compare, Layout, std::pmr::polymorphic_allocator<Pair<K, V>>>;
+} // namespace my::pmr
+
+#include "FlatMap.hpp"
+
+#endif // MY_FLAT_MAP_H
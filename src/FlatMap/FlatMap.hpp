@@ -0,0 +1,283 @@
+#ifndef MY_FLAT_MAP_IMPL_HPP
+#define MY_FLAT_MAP_IMPL_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#define FLATMAP_TEMPLATE_DECL()                                                                                        \
+    template <typename K, typename V, typename Compare, IsFlatLayout Layout, typename Alloc>
+
+namespace my {
+    FLATMAP_TEMPLATE_DECL()
+    FlatMap<K, V, Compare, Layout, Alloc>::FlatMap(const Alloc& allocator) noexcept
+        : m_Keys(KeyAllocator(allocator)), m_Values(ValueAllocator(allocator))
+    {
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    FlatMap<K, V, Compare, Layout, Alloc>::FlatMap(const Compare& compare, const Alloc& allocator)
+        : m_Compare(compare), m_Keys(KeyAllocator(allocator)), m_Values(ValueAllocator(allocator))
+    {
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename It>
+    FlatMap<K, V, Compare, Layout, Alloc>::FlatMap(It first, It last, const Compare& compare, const Alloc& allocator)
+        : FlatMap(compare, allocator)
+    {
+        Assign(first, last);
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    FlatMap<K, V, Compare, Layout, Alloc>::FlatMap(const std::initializer_list<Pair<K, V>> list,
+                                                   const Compare& compare, const Alloc& allocator)
+        : FlatMap(list.begin(), list.end(), compare, allocator)
+    {
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatMap<K, V, Compare, Layout, Alloc>::LowerIndex(const Q& key) const noexcept
+    {
+        return Layout::Search(m_Keys.Data(), Size(), [&](const K& element) { return m_Compare(element, key); });
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatMap<K, V, Compare, Layout, Alloc>::UpperIndex(const Q& key) const noexcept
+    {
+        return Layout::Search(m_Keys.Data(), Size(), [&](const K& element) { return !m_Compare(key, element); });
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatMap<K, V, Compare, Layout, Alloc>::FindIndex(const Q& key) const noexcept
+    {
+        const usize index = LowerIndex(key);
+        return index != Size() && !m_Compare(key, m_Keys[index]) ? index : Size();
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatMap<K, V, Compare, Layout, Alloc>::SortedRank(const KeyVec& keys, const Q& key) const noexcept
+    {
+        return SortedLayout::Search(keys.Data(), keys.Size(),
+                                    [&](const K& element) { return m_Compare(element, key); });
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename KArg, typename VArg>
+    bool FlatMap<K, V, Compare, Layout, Alloc>::InsertImpl(KArg&& key, VArg&& value)
+    {
+        const usize found = FindIndex(key);
+        if (found != Size())
+        {
+            m_Values[found] = std::forward<VArg>(value);
+            return true;
+        }
+
+        // Every other layout is rebuilt around the new element, which costs the same O(n) as shifting does.
+        KeyVec      keys   = ToSorted<Layout>(std::move(m_Keys));
+        ValueVec    values = ToSorted<Layout>(std::move(m_Values));
+        const usize rank   = SortedRank(keys, key);
+        try
+        {
+            keys.Insert(keys.begin() + rank, std::forward<KArg>(key));
+            try
+            {
+                values.Insert(values.begin() + rank, std::forward<VArg>(value));
+            }
+            catch (...)
+            {
+                keys.Erase(keys.begin() + rank);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            m_Keys   = ToLayout<Layout>(std::move(keys));
+            m_Values = ToLayout<Layout>(std::move(values));
+            throw;
+        }
+        m_Keys   = ToLayout<Layout>(std::move(keys));
+        m_Values = ToLayout<Layout>(std::move(values));
+        return false;
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename It>
+    void FlatMap<K, V, Compare, Layout, Alloc>::Assign(It first, It last)
+    {
+        Vec<Pair<K, V>> pairs{};
+        for (; first != last; ++first)
+            pairs.EmplaceBack((*first).first, (*first).second);
+
+        // A stable sort keeps equal keys in the order they came in, so the last one of each run is the newest.
+        Pair<K, V>* begin = pairs.Data();
+        Pair<K, V>* end   = begin + pairs.Size();
+        std::stable_sort(begin, end, [&](const Pair<K, V>& lhv, const Pair<K, V>& rhv) {
+            return m_Compare(lhv.first, rhv.first);
+        });
+
+        KeyVec   keys(m_Keys.GetAllocator());
+        ValueVec values(m_Values.GetAllocator());
+        keys.Reserve(pairs.Size());
+        values.Reserve(pairs.Size());
+        for (Pair<K, V>* it = begin; it != end; ++it)
+        {
+            if (it + 1 != end && !m_Compare(it->first, (it + 1)->first))
+                continue;
+            keys.Push(std::move(it->first));
+            values.Push(std::move(it->second));
+        }
+        m_Keys   = ToLayout<Layout>(std::move(keys));
+        m_Values = ToLayout<Layout>(std::move(values));
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    bool FlatMap<K, V, Compare, Layout, Alloc>::Insert(const K& key, const V& value)
+    {
+        return InsertImpl(key, value);
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    bool FlatMap<K, V, Compare, Layout, Alloc>::Insert(K&& key, V&& value)
+    {
+        return InsertImpl(std::move(key), std::move(value));
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    V* FlatMap<K, V, Compare, Layout, Alloc>::Find(const KeyArg<Q>& key) noexcept
+    {
+        const usize index = FindIndex(key);
+        return index == Size() ? nullptr : &m_Values[index];
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    const V* FlatMap<K, V, Compare, Layout, Alloc>::Find(const KeyArg<Q>& key) const noexcept
+    {
+        const usize index = FindIndex(key);
+        return index == Size() ? nullptr : &m_Values[index];
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    V& FlatMap<K, V, Compare, Layout, Alloc>::At(const KeyArg<Q>& key)
+    {
+        V* value = Find<Q>(key);
+        if (!value)
+            throw std::invalid_argument("It does not exist.");
+        return *value;
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    const V& FlatMap<K, V, Compare, Layout, Alloc>::At(const KeyArg<Q>& key) const
+    {
+        const V* value = Find<Q>(key);
+        if (!value)
+            throw std::invalid_argument("It does not exist.");
+        return *value;
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    bool FlatMap<K, V, Compare, Layout, Alloc>::ContainsKey(const KeyArg<Q>& key) const noexcept
+    {
+        return FindIndex(key) != Size();
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    bool FlatMap<K, V, Compare, Layout, Alloc>::Erase(const KeyArg<Q>& key)
+    {
+        if (FindIndex(key) == Size())
+            return false;
+
+        KeyVec      keys   = ToSorted<Layout>(std::move(m_Keys));
+        ValueVec    values = ToSorted<Layout>(std::move(m_Values));
+        const usize rank   = SortedRank(keys, key);
+        keys.Erase(keys.begin() + rank);
+        values.Erase(values.begin() + rank);
+        m_Keys   = ToLayout<Layout>(std::move(keys));
+        m_Values = ToLayout<Layout>(std::move(values));
+        return true;
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatMap<K, V, Compare, Layout, Alloc>::ConstIterator FlatMap<K, V, Compare, Layout, Alloc>::LowerBound(
+        const KeyArg<Q>& key) const noexcept
+    {
+        return MakeIterator<true>(LowerIndex(key));
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatMap<K, V, Compare, Layout, Alloc>::ConstIterator FlatMap<K, V, Compare, Layout, Alloc>::UpperBound(
+        const KeyArg<Q>& key) const noexcept
+    {
+        return MakeIterator<true>(UpperIndex(key));
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatMap<K, V, Compare, Layout, Alloc>::template View<
+        typename FlatMap<K, V, Compare, Layout, Alloc>::ConstIterator>
+    FlatMap<K, V, Compare, Layout, Alloc>::Range(const KeyArg<Q>& low, const KeyArg<Q>& high) const noexcept
+    {
+        if (!m_Compare(low, high))
+            return { cend(), cend() };
+        return { LowerBound<Q>(low), LowerBound<Q>(high) };
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    template <typename Q>
+    std::vector<Pair<K, V>> FlatMap<K, V, Compare, Layout, Alloc>::RangeQuery(const KeyArg<Q>& begin,
+                                                                             const KeyArg<Q>& end) const
+    {
+        std::vector<Pair<K, V>> pairs;
+        if (!m_Compare(begin, end))
+            return pairs;
+
+        for (auto it = UpperBound<Q>(begin); it != cend() && m_Compare(it->first, end); ++it)
+            pairs.emplace_back(it->first, it->second);
+        return pairs;
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    void FlatMap<K, V, Compare, Layout, Alloc>::Clear() noexcept
+    {
+        m_Keys.Clear();
+        m_Values.Clear();
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    void FlatMap<K, V, Compare, Layout, Alloc>::Reserve(const usize count)
+    {
+        m_Keys.Reserve(count);
+        m_Values.Reserve(count);
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    void FlatMap<K, V, Compare, Layout, Alloc>::ShrinkToFit()
+    {
+        m_Keys.ShrinkToFit();
+        m_Values.ShrinkToFit();
+    }
+
+    FLATMAP_TEMPLATE_DECL()
+    void FlatMap<K, V, Compare, Layout, Alloc>::Swap(FlatMap<K, V, Compare, Layout, Alloc>& other) noexcept
+    {
+        std::swap(m_Compare, other.m_Compare);
+        m_Keys.Swap(other.m_Keys);
+        m_Values.Swap(other.m_Values);
+    }
+} // namespace my
+
+#undef FLATMAP_TEMPLATE_DECL
+
+#endif // MY_FLAT_MAP_IMPL_HPP
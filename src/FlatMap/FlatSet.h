@@ -0,0 +1,192 @@
+#ifndef MY_FLAT_SET_H
+#define MY_FLAT_SET_H
+
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include <CommonDef.h>
+
+#include "../HashMap/Utilities/KeyArg.h"
+#include "../Memory/Allocator.h"
+#include "../Vector/Vector.h"
+#include "FlatLayout.h"
+
+namespace my {
+    // The set counterpart of FlatMap, the keys alone in a single my::Vec.
+    template <typename K, typename Compare = std::less<>, IsFlatLayout Layout = SortedLayout,
+              typename Alloc = Allocator<K>>
+    class FlatSet
+    {
+    private:
+        using KeyVec = Vec<K, DefaultGrowth, Alloc>;
+
+        static constexpr bool IsTransparent = requires { typename Compare::is_transparent; };
+
+        template <typename Q>
+        using KeyArg = typename KeyArgOf<IsTransparent>::template Type<Q, K>;
+
+    public:
+        // Keys in key order, always const since changing one in place could break the order.
+        class ConstIterator
+        {
+            friend class FlatSet;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = ptrdiff;
+            using value_type        = K;
+            using pointer           = const K*;
+            using reference         = const K&;
+
+        private:
+            const K* m_Keys  = nullptr;
+            usize    m_Index = 0;
+            usize    m_Size  = 0;
+
+        private:
+            ConstIterator(const K* keys, const usize index, const usize size) noexcept
+                : m_Keys(keys), m_Index(index), m_Size(size)
+            {
+            }
+
+        public:
+            ConstIterator() noexcept = default;
+
+        public:
+            constexpr reference operator*() const noexcept { return m_Keys[m_Index]; }
+            constexpr pointer   operator->() const noexcept { return m_Keys + m_Index; }
+            ConstIterator&      operator++() noexcept
+            {
+                m_Index = Layout::Next(m_Index, m_Size);
+                return *this;
+            }
+            ConstIterator operator++(const i32) noexcept
+            {
+                auto t = *this;
+                ++(*this);
+                return t;
+            }
+
+        public:
+            friend bool operator==(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            {
+                return lhv.m_Keys == rhv.m_Keys && lhv.m_Index == rhv.m_Index;
+            }
+            friend bool operator!=(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            {
+                return !(lhv == rhv);
+            }
+        };
+        using Iterator = ConstIterator;
+
+        // A half open range of keys in key order, valid as long as its iterators are.
+        class View
+        {
+        private:
+            ConstIterator m_Begin;
+            ConstIterator m_End;
+
+        public:
+            View(const ConstIterator begin, const ConstIterator end) noexcept : m_Begin(begin), m_End(end) {}
+
+        public:
+            constexpr ConstIterator begin() const noexcept { return m_Begin; }
+            constexpr ConstIterator end() const noexcept { return m_End; }
+            constexpr bool          Empty() const noexcept { return m_Begin == m_End; }
+        };
+
+    private:
+        [[no_unique_address]] Compare m_Compare{};
+        KeyVec                        m_Keys;
+
+    public:
+        FlatSet() = default;
+        explicit FlatSet(const Alloc& allocator) noexcept;
+        explicit FlatSet(const Compare& compare, const Alloc& allocator = Alloc());
+        template <typename It>
+        FlatSet(It first, It last, const Compare& compare = Compare(), const Alloc& allocator = Alloc());
+        FlatSet(const std::initializer_list<K> list, const Compare& compare = Compare(),
+                const Alloc& allocator = Alloc());
+
+    private:
+        template <typename Q>
+        usize LowerIndex(const Q& key) const noexcept;
+        template <typename Q>
+        usize UpperIndex(const Q& key) const noexcept;
+        template <typename Q>
+        usize FindIndex(const Q& key) const noexcept;
+        template <typename KArg>
+        bool  InsertImpl(KArg&& key);
+
+    public:
+        // Replaces the contents with the keys of the range, duplicates are dropped.
+        template <typename It>
+        void              Assign(It first, It last);
+        // Returns true if the key was inserted, false if it was already there.
+        bool              Insert(const K& key);
+        bool              Insert(K&& key);
+        template <typename Q = K>
+        bool              Contains(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        bool              Erase(const KeyArg<Q>& key);
+        template <typename Q = K>
+        ConstIterator     Find(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        ConstIterator     LowerBound(const KeyArg<Q>& key) const noexcept;
+        template <typename Q = K>
+        ConstIterator     UpperBound(const KeyArg<Q>& key) const noexcept;
+        // The keys in [low, high) without copying any of them.
+        template <typename Q = K>
+        View              Range(const KeyArg<Q>& low, const KeyArg<Q>& high) const noexcept;
+        // The keys strictly between begin and end, in key order, like BinaryTree::RangeQuery().
+        template <typename Q = K>
+        std::vector<K>    RangeQuery(const KeyArg<Q>& begin, const KeyArg<Q>& end) const;
+        void              Clear() noexcept { m_Keys.Clear(); }
+        void              Reserve(const usize count) { m_Keys.Reserve(count); }
+        void              ShrinkToFit() { m_Keys.ShrinkToFit(); }
+        void              Swap(FlatSet<K, Compare, Layout, Alloc>& other) noexcept;
+        constexpr Alloc   GetAllocator() const noexcept { return m_Keys.GetAllocator(); }
+        constexpr Compare KeyComp() const { return m_Compare; }
+
+    public:
+        constexpr usize Size() const noexcept { return m_Keys.Size(); }
+        constexpr bool  Empty() const noexcept { return m_Keys.Empty(); }
+
+    public:
+        ConstIterator begin() const noexcept { return ConstIterator(m_Keys.Data(), Layout::First(Size()), Size()); }
+        ConstIterator end() const noexcept { return ConstIterator(m_Keys.Data(), Size(), Size()); }
+        ConstIterator cbegin() const noexcept { return begin(); }
+        ConstIterator cend() const noexcept { return end(); }
+
+    public:
+        friend std::ostream& operator<<(std::ostream& stream, const FlatSet<K, Compare, Layout, Alloc>& set)
+        {
+            bool first = true;
+            stream << "{ ";
+            for (const K& key : set)
+            {
+                if (!first)
+                    stream << ", ";
+                stream << key;
+                first = false;
+            }
+            stream << " }";
+            return stream;
+        }
+    };
+} // namespace my
+
+namespace my::pmr {
+    template <typename K, typename Compare = std::less<>, IsFlatLayout Layout = SortedLayout>
+    using FlatSet = my::FlatSet<K, Compare, Layout, std::pmr::polymorphic_allocator<K>>;
+} // namespace my::pmr
+
+#include "FlatSet.hpp"
+
+#endif // MY_FLAT_SET_H
@@ -0,0 +1,190 @@
+#ifndef MY_FLAT_SET_IMPL_HPP
+#define MY_FLAT_SET_IMPL_HPP
+
+#include <algorithm>
+#include <utility>
+
+#define FLATSET_TEMPLATE_DECL() template <typename K, typename Compare, IsFlatLayout Layout, typename Alloc>
+
+namespace my {
+    FLATSET_TEMPLATE_DECL()
+    FlatSet<K, Compare, Layout, Alloc>::FlatSet(const Alloc& allocator) noexcept : m_Keys(allocator)
+    {
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    FlatSet<K, Compare, Layout, Alloc>::FlatSet(const Compare& compare, const Alloc& allocator)
+        : m_Compare(compare), m_Keys(allocator)
+    {
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename It>
+    FlatSet<K, Compare, Layout, Alloc>::FlatSet(It first, It last, const Compare& compare, const Alloc& allocator)
+        : FlatSet(compare, allocator)
+    {
+        Assign(first, last);
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    FlatSet<K, Compare, Layout, Alloc>::FlatSet(const std::initializer_list<K> list, const Compare& compare,
+                                                const Alloc& allocator)
+        : FlatSet(list.begin(), list.end(), compare, allocator)
+    {
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatSet<K, Compare, Layout, Alloc>::LowerIndex(const Q& key) const noexcept
+    {
+        return Layout::Search(m_Keys.Data(), Size(), [&](const K& element) { return m_Compare(element, key); });
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatSet<K, Compare, Layout, Alloc>::UpperIndex(const Q& key) const noexcept
+    {
+        return Layout::Search(m_Keys.Data(), Size(), [&](const K& element) { return !m_Compare(key, element); });
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    usize FlatSet<K, Compare, Layout, Alloc>::FindIndex(const Q& key) const noexcept
+    {
+        const usize index = LowerIndex(key);
+        return index != Size() && !m_Compare(key, m_Keys[index]) ? index : Size();
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename KArg>
+    bool FlatSet<K, Compare, Layout, Alloc>::InsertImpl(KArg&& key)
+    {
+        if (FindIndex(key) != Size())
+            return false;
+
+        KeyVec      keys = ToSorted<Layout>(std::move(m_Keys));
+        const usize rank = SortedLayout::Search(keys.Data(), keys.Size(),
+                                                [&](const K& element) { return m_Compare(element, key); });
+        try
+        {
+            keys.Insert(keys.begin() + rank, std::forward<KArg>(key));
+        }
+        catch (...)
+        {
+            m_Keys = ToLayout<Layout>(std::move(keys));
+            throw;
+        }
+        m_Keys = ToLayout<Layout>(std::move(keys));
+        return true;
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename It>
+    void FlatSet<K, Compare, Layout, Alloc>::Assign(It first, It last)
+    {
+        KeyVec keys(m_Keys.GetAllocator());
+        for (; first != last; ++first)
+            keys.EmplaceBack(*first);
+
+        K* begin = keys.Data();
+        K* end   = begin + keys.Size();
+        std::sort(begin, end, m_Compare);
+        const auto unique =
+            std::unique(begin, end, [&](const K& lhv, const K& rhv) { return !m_Compare(lhv, rhv); });
+        if (unique != end)
+            keys.Erase(keys.begin() + usize(unique - begin), keys.end());
+        m_Keys = ToLayout<Layout>(std::move(keys));
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    bool FlatSet<K, Compare, Layout, Alloc>::Insert(const K& key)
+    {
+        return InsertImpl(key);
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    bool FlatSet<K, Compare, Layout, Alloc>::Insert(K&& key)
+    {
+        return InsertImpl(std::move(key));
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    bool FlatSet<K, Compare, Layout, Alloc>::Contains(const KeyArg<Q>& key) const noexcept
+    {
+        return FindIndex(key) != Size();
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    bool FlatSet<K, Compare, Layout, Alloc>::Erase(const KeyArg<Q>& key)
+    {
+        if (FindIndex(key) == Size())
+            return false;
+
+        KeyVec      keys = ToSorted<Layout>(std::move(m_Keys));
+        const usize rank = SortedLayout::Search(keys.Data(), keys.Size(),
+                                                [&](const K& element) { return m_Compare(element, key); });
+        keys.Erase(keys.begin() + rank);
+        m_Keys = ToLayout<Layout>(std::move(keys));
+        return true;
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatSet<K, Compare, Layout, Alloc>::ConstIterator FlatSet<K, Compare, Layout, Alloc>::Find(
+        const KeyArg<Q>& key) const noexcept
+    {
+        return ConstIterator(m_Keys.Data(), FindIndex(key), Size());
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatSet<K, Compare, Layout, Alloc>::ConstIterator FlatSet<K, Compare, Layout, Alloc>::LowerBound(
+        const KeyArg<Q>& key) const noexcept
+    {
+        return ConstIterator(m_Keys.Data(), LowerIndex(key), Size());
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatSet<K, Compare, Layout, Alloc>::ConstIterator FlatSet<K, Compare, Layout, Alloc>::UpperBound(
+        const KeyArg<Q>& key) const noexcept
+    {
+        return ConstIterator(m_Keys.Data(), UpperIndex(key), Size());
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    typename FlatSet<K, Compare, Layout, Alloc>::View FlatSet<K, Compare, Layout, Alloc>::Range(
+        const KeyArg<Q>& low, const KeyArg<Q>& high) const noexcept
+    {
+        if (!m_Compare(low, high))
+            return { end(), end() };
+        return { LowerBound<Q>(low), LowerBound<Q>(high) };
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    template <typename Q>
+    std::vector<K> FlatSet<K, Compare, Layout, Alloc>::RangeQuery(const KeyArg<Q>& begin, const KeyArg<Q>& end) const
+    {
+        std::vector<K> keys;
+        if (!m_Compare(begin, end))
+            return keys;
+
+        for (auto it = UpperBound<Q>(begin); it != cend() && m_Compare(*it, end); ++it)
+            keys.emplace_back(*it);
+        return keys;
+    }
+
+    FLATSET_TEMPLATE_DECL()
+    void FlatSet<K, Compare, Layout, Alloc>::Swap(FlatSet<K, Compare, Layout, Alloc>& other) noexcept
+    {
+        std::swap(m_Compare, other.m_Compare);
+        m_Keys.Swap(other.m_Keys);
+    }
+} // namespace my
+
+#undef FLATSET_TEMPLATE_DECL
+
+#endif // MY_FLAT_SET_IMPL_HPP
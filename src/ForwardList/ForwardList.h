@@ -5,203 +5,233 @@
 #include <cstdlib>
 #include <cstring>
 #include <exception>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <CommonDef.h>
 
+#include "../Memory/Allocator.h"
+#include "../Memory/NodePool.h"
+
 namespace my {
-    template <typename T>
+    template <typename T, typename Alloc = Allocator<T>>
     class ForwardList
     {
     private:
-        struct Node
+        // The list starts at a bare link that is not a node, so inserting or erasing after it works the same as
+        // after any node, and BeforeBegin() has something to point at.
+        struct Link
+        {
+            Link* next = nullptr;
+        };
+        struct Node : Link
         {
-            T     obj{};
-            Node* next = nullptr;
+            T obj;
 
         public:
-            Node() noexcept;
-            Node(const T& obj) noexcept;
+            template <typename... TArgs>
+            explicit Node(std::in_place_t, TArgs&&... args);
         };
-        class ConstIterator;
-        class Iterator
+        using NodeAllocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+        using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+        using Pool            = NodePool<Node, Alloc>;
+
+        // Holds the link it is at, so stepping is a single load. Iterators stay valid until the element they
+        // point at is erased.
+        template <bool Const>
+        class BasicIterator
         {
-            friend class ConstIterator;
+            template <bool>
+            friend class BasicIterator;
+            friend class ForwardList;
 
-            using iterator_category = std::forward_iterator_tag;
-            using difference_type   = usize;
-            using value_type        = ForwardList<T>;
-            using pointer           = value_type*;
-            using reference         = T&;
-
-        private:
-            pointer m_Ptr;
-            usize   m_Index;
-
-        public:
-            Iterator(pointer ptr = nullptr, const usize index = 0) noexcept : m_Ptr(ptr), m_Index(index) {}
+            using LinkPointer = std::conditional_t<Const, const Link*, Link*>;
+            using NodePointer = std::conditional_t<Const, const Node*, Node*>;
 
         public:
-            constexpr reference operator*() const noexcept { return m_Ptr->operator[](m_Index); }
-            constexpr pointer   operator->() const noexcept { return m_Ptr; };
-            inline Iterator&    operator++() noexcept
-            {
-                m_Index++;
-                return *this;
-            }
-            Iterator operator++(const i32) noexcept
-            {
-                auto t = *this;
-                ++(*this);
-                return t;
-            }
-            constexpr difference_type operator-(const Iterator& other) const noexcept
-            {
-                return m_Index - other.m_Index;
-            }
-            inline Iterator operator+(const uintptr disp) const noexcept
-            {
-                Iterator temp = *this;
-                temp.m_Index += disp;
-                return temp;
-            };
-            inline Iterator operator-(const uintptr disp) const noexcept
-            {
-                Iterator temp = *this;
-                temp.m_Index -= disp;
-                return temp;
-            }
-
-        public:
-            friend bool operator==(const Iterator& lhv, const Iterator& rhv) noexcept
-            {
-                return lhv.m_Ptr == rhv.m_Ptr && lhv.m_Index == rhv.m_Index;
-            }
-            friend bool operator!=(const Iterator& lhv, const Iterator& rhv) noexcept { return !(lhv == rhv); }
-        };
-        class ConstIterator
-        {
             using iterator_category = std::forward_iterator_tag;
-            using difference_type   = usize;
-            using value_type        = ForwardList<T>;
-            using pointer           = const value_type*;
-            using reference         = const T&;
+            using difference_type   = ptrdiff;
+            using value_type        = T;
+            using pointer           = std::conditional_t<Const, const T*, T*>;
+            using reference         = std::conditional_t<Const, const T&, T&>;
 
         private:
-            pointer m_Ptr;
-            usize   m_Index;
+            LinkPointer m_Link = nullptr; // nullptr is the end.
 
-        public:
-            ConstIterator(const Iterator it) noexcept : m_Ptr(it.m_Ptr), m_Index(it.m_Index) {}
-            ConstIterator(pointer ptr = nullptr, const usize index = 0) noexcept : m_Ptr(ptr), m_Index(index) {}
+        private:
+            explicit BasicIterator(LinkPointer link) noexcept : m_Link(link) {}
 
         public:
-            constexpr reference operator*() const noexcept
+            BasicIterator() noexcept = default;
+            template <bool OtherConst>
+                requires(Const && !OtherConst)
+            BasicIterator(const BasicIterator<OtherConst>& other) noexcept : m_Link(other.m_Link)
             {
-                return (reference)((value_type*)m_Ptr)->operator[](m_Index);
             }
-            constexpr pointer     operator->() const noexcept { return m_Ptr; };
-            inline ConstIterator& operator++() noexcept
+
+        public:
+            constexpr reference operator*() const noexcept { return static_cast<NodePointer>(m_Link)->obj; }
+            constexpr pointer   operator->() const noexcept { return &static_cast<NodePointer>(m_Link)->obj; }
+            BasicIterator&      operator++() noexcept
             {
-                m_Index++;
+                m_Link = m_Link->next;
                 return *this;
             }
-            ConstIterator operator++(const i32) noexcept
+            BasicIterator operator++(const i32) noexcept
             {
                 auto t = *this;
                 ++(*this);
                 return t;
             }
-            constexpr difference_type operator-(const ConstIterator& other) const noexcept
-            {
-                return m_Index - other.m_Index;
-            }
-            inline ConstIterator operator+(const uintptr disp) const noexcept
-            {
-                ConstIterator temp = *this;
-                temp.m_Index += disp;
-                return temp;
-            };
-            inline ConstIterator operator-(const uintptr disp) const noexcept
-            {
-                ConstIterator temp = *this;
-                temp.m_Index -= disp;
-                return temp;
-            }
 
         public:
-            friend bool operator==(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            friend bool operator==(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
             {
-                return lhv.m_Ptr == rhv.m_Ptr && lhv.m_Index == rhv.m_Index;
+                return lhv.m_Link == rhv.m_Link;
             }
-            friend bool operator!=(const ConstIterator& lhv, const ConstIterator& rhv) noexcept
+            friend bool operator!=(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
             {
                 return !(lhv == rhv);
             }
         };
 
+    public:
+        using Iterator      = BasicIterator<false>;
+        using ConstIterator = BasicIterator<true>;
+
     private:
-        Node* m_Head   = nullptr;
+        Pool  m_Pool{};
+        Link  m_Before{};         // m_Before.next is the first node.
+        Node* m_Last   = nullptr; // The last node, so appending does not have to walk the list.
         usize m_Length = 0;
 
     public:
         ForwardList();
-        ForwardList(const std::initializer_list<T> list);
-        ForwardList(const ForwardList<T>& other);
-        ForwardList(ForwardList<T>&& other) noexcept;
+        explicit ForwardList(const Alloc& allocator) noexcept;
+        ForwardList(const std::initializer_list<T> list, const Alloc& allocator = Alloc());
+        ForwardList(const ForwardList<T, Alloc>& other);
+        ForwardList(ForwardList<T, Alloc>&& other) noexcept;
         ~ForwardList();
 
     private:
-        inline void                    Drop() noexcept;
-        inline std::pair<Node*, Node*> GetPreviousAndLast() noexcept;
-        inline Node*                   GetNodeAt(const usize index);
+        inline void  Drop() noexcept;
+        template <typename... TArgs>
+        inline Node* CreateNode(TArgs&&... args);
+        inline void  DestroyNode(Node* node) noexcept;
+        inline Node* GetNodeAt(const usize index);
+        // The link whose next is pos, and the last one, whose next is nullptr.
+        inline Link* GetLinkBefore(const ConstIterator pos) noexcept;
+        inline Link* GetLastLink() noexcept { return m_Last ? m_Last : &m_Before; }
+        // Whether the nodes of other can be relinked into this list as they are. That takes a shared allocator and
+        // only pays off while other's pool is not mostly unused slots, see NodePool::IsDense().
+        inline bool  CanAdopt(const ForwardList<T, Alloc>& other) const noexcept;
+        // Records that nothing follows link anymore.
+        inline void  SetLast(Link* link) noexcept { m_Last = link == &m_Before ? nullptr : AsNode(link); }
+        // Links copies of the range in after link, returning the last of them (or link if there are none).
+        template <typename It>
+        Link*        LinkRangeAfter(Link* link, It first, It last);
+        static Node* AsNode(Link* link) noexcept { return static_cast<Node*>(link); }
+        // Merges the nullptr terminated runs a and b into a, leaving b empty, and returns whether the result ends
+        // with the last node of b. If cmp throws, a holds what was merged so far followed by the rest of a, and
+        // b the rest of b.
+        template <typename Compare, typename Proj>
+        static bool  MergeRuns(Link*& a, Link*& b, Compare& cmp, Proj& proj);
 
     public:
         constexpr bool       Empty() const noexcept { return m_Length == 0; }
         constexpr usize      Size() const noexcept { return m_Length; }
         constexpr usize      MaxSize() const noexcept { return std::numeric_limits<usize>::max() / sizeof(Node); }
-        inline Iterator      begin() noexcept { return Iterator(this, 0); }
-        inline Iterator      end() noexcept { return Iterator(this, m_Length); }
-        inline ConstIterator cbegin() const noexcept { return ConstIterator(this, 0); }
-        inline ConstIterator cend() const noexcept { return ConstIterator(this, m_Length); }
+        constexpr Alloc      GetAllocator() const noexcept { return Alloc(m_Pool.GetAllocator()); }
+        inline Iterator      begin() noexcept { return Iterator(m_Before.next); }
+        inline Iterator      end() noexcept { return Iterator(nullptr); }
+        inline ConstIterator begin() const noexcept { return ConstIterator(m_Before.next); }
+        inline ConstIterator end() const noexcept { return ConstIterator(nullptr); }
+        inline ConstIterator cbegin() const noexcept { return begin(); }
+        inline ConstIterator cend() const noexcept { return end(); }
+        // The position before the first element, only good for the ...After() functions and for incrementing.
+        inline Iterator      BeforeBegin() noexcept { return Iterator(&m_Before); }
+        inline ConstIterator BeforeBegin() const noexcept { return ConstIterator(&m_Before); }
+        inline ConstIterator CBeforeBegin() const noexcept { return BeforeBegin(); }
 
     public:
         inline void     Push(const T& e);
+        inline void     Push(T&& e);
         inline void     PushFront(const T& e);
+        inline void     PushFront(T&& e);
+        template <typename... TArgs>
+        inline T&       EmplaceBack(TArgs&&... args);
+        template <typename... TArgs>
+        inline T&       EmplaceFront(TArgs&&... args);
         inline T        Pop();
         inline T        PopFront();
         inline T&       Frost();
         inline const T& Frost() const;
         inline void     Clear();
         inline void     Resize(const usize newSize);
-        constexpr void  Swap(ForwardList<T>& other);
+        constexpr void  Swap(ForwardList<T, Alloc>& other);
+        // Erase() and Insert() look for the element before pos first, which makes them O(n). The ...After()
+        // functions take that element instead and are O(1), like those of std::forward_list.
         void            Erase(const ConstIterator pos);
+        // Erases first through last, both included.
         void            Erase(const ConstIterator first, const ConstIterator last);
         void            Insert(const ConstIterator pos, const T& e);
         void            Insert(const ConstIterator pos, const ConstIterator first, const ConstIterator last);
+        // Return an iterator to the (last) inserted element, or pos if nothing was inserted.
+        Iterator        InsertAfter(const ConstIterator pos, const T& e);
+        Iterator        InsertAfter(const ConstIterator pos, T&& e);
+        template <typename It>
+        Iterator        InsertAfter(const ConstIterator pos, It first, It last);
+        template <typename... TArgs>
+        Iterator        EmplaceAfter(const ConstIterator pos, TArgs&&... args);
+        // Erase the element after pos, or the ones strictly between first and last, returning an iterator to
+        // the element after the erased ones.
+        Iterator        EraseAfter(const ConstIterator pos);
+        Iterator        EraseAfter(const ConstIterator first, const ConstIterator last);
+        // Copy a range onto the back, in O(1) per element.
+        template <typename It>
+        void            Append(It first, It last);
+        void            Append(const std::initializer_list<T> list);
+        // Move every element of other after pos, or onto the back, leaving other empty. The nodes are relinked in
+        // O(1) and this pool takes over the slabs of other's. If the allocators differ, or other's pool is mostly
+        // unused slots that would otherwise be kept alive, the elements are moved over one by one instead.
+        void            SpliceAfter(const ConstIterator pos, ForwardList<T, Alloc>& other);
+        void            Splice(ForwardList<T, Alloc>& other);
         void            Reverse();
-        void            Sort();
+        // A stable merge sort that only relinks the nodes, O(n log n) without allocating. If cmp or proj throws,
+        // the elements are all still there, in some order.
+        template <typename Compare = std::less<>, typename Proj = std::identity>
+        void            Sort(Compare cmp = {}, Proj proj = {});
+        // Moves the elements of other, which like this list has to be sorted by cmp, into their place in this
+        // one, leaving other empty. Equal elements of this list stay in front of those of other.
+        template <typename Compare = std::less<>, typename Proj = std::identity>
+        void            Merge(ForwardList<T, Alloc>& other, Compare cmp = {}, Proj proj = {});
+        // Erases all but the first of every run of consecutive equal elements, returning how many were erased.
+        template <typename Pred = std::equal_to<>>
+        usize           Unique(Pred pred = {});
 
     public:
-        inline T&              operator[](const usize index) noexcept;
-        inline ForwardList<T>& operator=(const ForwardList<T>& other);
-        inline ForwardList<T>& operator=(ForwardList<T>&& other) noexcept;
+        inline T&                     operator[](const usize index) noexcept;
+        inline ForwardList<T, Alloc>& operator=(const ForwardList<T, Alloc>& other);
+        inline ForwardList<T, Alloc>& operator=(ForwardList<T, Alloc>&& other) noexcept(
+            NodeAllocTraits::propagate_on_container_move_assignment::value || NodeAllocTraits::is_always_equal::value);
 
     public:
-        friend std::ostream& operator<<(std::ostream& stream, const ForwardList<T>& other) noexcept
+        friend std::ostream& operator<<(std::ostream& stream, const ForwardList<T, Alloc>& other) noexcept
         {
             stream << "[ ";
-            for (auto* c = other.m_Head; c; c = c->next)
+            for (auto it = other.begin(); it != other.end();)
             {
-                if (c->next)
-                    stream << c->obj << ", ";
-                else
-                    stream << c->obj;
+                stream << *it;
+                if (++it != other.end())
+                    stream << ", ";
             }
             stream << " ]";
             return stream;
@@ -209,5 +239,10 @@ namespace my {
     };
 } // namespace my
 
+namespace my::pmr {
+    template <typename T>
+    using ForwardList = my::ForwardList<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace my::pmr
+
 #include "ForwardList.hpp"
 #endif // FORWARD_LIST_H
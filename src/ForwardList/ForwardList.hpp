@@ -2,406 +2,644 @@
 #define FORWARD_LIST_IMPL_H
 
 namespace my {
-    template <typename T>
-    using Node = typename ForwardList<T>::Node;
-
-    template <typename T>
-    ForwardList<T>::Node::Node() noexcept = default;
-
-    template <typename T>
-    ForwardList<T>::Node::Node(const T& obj) noexcept : obj(obj)
+    template <typename T, typename Alloc>
+    template <typename... TArgs>
+    ForwardList<T, Alloc>::Node::Node(std::in_place_t, TArgs&&... args) : obj(std::forward<TArgs>(args)...)
     {
     }
 
-    template <typename T>
-    ForwardList<T>::ForwardList(const ForwardList<T>& other)
+    template <typename T, typename Alloc>
+    ForwardList<T, Alloc>::ForwardList(const ForwardList<T, Alloc>& other)
+        : m_Pool(NodeAllocTraits::select_on_container_copy_construction(other.m_Pool.GetAllocator()))
     {
-        if (!other.m_Head)
-            return;
-
-        m_Head             = new Node(other.m_Head->obj);
-        auto* current      = other.m_Head->next;
-        auto* this_current = m_Head;
-        while (current)
-        {
-            this_current->next = new Node(current->obj);
-            current            = current->next;
-            this_current       = this_current->next;
-        }
+        LinkRangeAfter(&m_Before, other.begin(), other.end());
     }
 
-    template <typename T>
-    ForwardList<T>::ForwardList(ForwardList<T>&& other) noexcept
+    template <typename T, typename Alloc>
+    ForwardList<T, Alloc>::ForwardList(ForwardList<T, Alloc>&& other) noexcept
+        : m_Pool(std::move(other.m_Pool))
     {
-        if (other.m_Head)
-        {
-            m_Head         = other.m_Head;
-            m_Length       = other.m_Length;
-            other.m_Head   = nullptr;
-            other.m_Length = 0;
-        }
+        m_Before.next = std::exchange(other.m_Before.next, nullptr);
+        m_Last        = std::exchange(other.m_Last, nullptr);
+        m_Length      = std::exchange(other.m_Length, 0);
     }
 
-    template <typename T>
-    ForwardList<T>::ForwardList() = default;
+    template <typename T, typename Alloc>
+    ForwardList<T, Alloc>::ForwardList() = default;
+
+    template <typename T, typename Alloc>
+    ForwardList<T, Alloc>::ForwardList(const Alloc& allocator) noexcept : m_Pool(allocator)
+    {
+    }
 
-    template <typename T>
-    ForwardList<T>::ForwardList(const std::initializer_list<T> list)
+    template <typename T, typename Alloc>
+    ForwardList<T, Alloc>::ForwardList(const std::initializer_list<T> list, const Alloc& allocator)
+        : m_Pool(allocator)
     {
         for (const auto& e : list)
             Push(e);
     }
 
-    template <typename T>
-    ForwardList<T>::~ForwardList()
+    template <typename T, typename Alloc>
+    ForwardList<T, Alloc>::~ForwardList()
     {
         Drop();
     }
 
-    template <typename T>
-    inline void ForwardList<T>::Drop() noexcept
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::Drop() noexcept
     {
-        auto* current = m_Head;
-        while (current)
+        // The nodes only have to be visited if they have a destructor to run, their memory goes back to the
+        // allocator a whole slab at a time.
+        if constexpr (!std::is_trivially_destructible_v<Node>)
         {
-            auto* temp = current;
-            current    = current->next;
-            delete temp;
+            for (Link* current = m_Before.next; current;)
+            {
+                Node* node = AsNode(current);
+                current    = current->next;
+                std::destroy_at(node);
+            }
         }
-        m_Head = nullptr;
+        m_Pool.Release();
+        m_Before.next = nullptr;
+        m_Last        = nullptr;
+        m_Length      = 0;
     }
 
-    template <typename T>
-    inline std::pair<Node<T>*, Node<T>*> ForwardList<T>::GetPreviousAndLast() noexcept
+    template <typename T, typename Alloc>
+    template <typename... TArgs>
+    inline ForwardList<T, Alloc>::Node* ForwardList<T, Alloc>::CreateNode(TArgs&&... args)
     {
-        Node* first_last  = m_Head;
-        Node* second_last = nullptr;
-        Node* current     = m_Head;
-        while (current->next)
+        Node* node = m_Pool.Allocate();
+        try
         {
-            second_last = first_last;
-            first_last  = first_last->next;
-            current     = current->next;
+            std::construct_at(node, std::forward<TArgs>(args)...);
         }
-        return { second_last, first_last };
+        catch (...)
+        {
+            m_Pool.Deallocate(node);
+            throw;
+        }
+        return node;
     }
 
-    template <typename T>
-    inline ForwardList<T>::Node* ForwardList<T>::GetNodeAt(const usize index)
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::DestroyNode(Node* node) noexcept
     {
-        if (index < 0 || !m_Head)
-            return nullptr;
+        std::destroy_at(node);
+        m_Pool.Deallocate(node);
+    }
 
-        auto* current = m_Head;
-        auto  count   = 0;
+    template <typename T, typename Alloc>
+    inline typename ForwardList<T, Alloc>::Link* ForwardList<T, Alloc>::GetLinkBefore(const ConstIterator pos) noexcept
+    {
+        Link* link = &m_Before;
+        while (link->next != pos.m_Link)
+            link = link->next;
+        return link;
+    }
 
-        while (current)
+    template <typename T, typename Alloc>
+    inline bool ForwardList<T, Alloc>::CanAdopt(const ForwardList<T, Alloc>& other) const noexcept
+    {
+        if constexpr (!NodeAllocTraits::is_always_equal::value)
         {
-            if (count++ == index)
-                return current;
-            current = current->next;
+            if (m_Pool.GetAllocator() != other.m_Pool.GetAllocator())
+                return false;
         }
-
-        return nullptr;
+        return other.m_Pool.IsDense(other.m_Length);
     }
 
-    template <typename T>
-    inline void ForwardList<T>::Push(const T& e)
+    template <typename T, typename Alloc>
+    template <typename It>
+    typename ForwardList<T, Alloc>::Link* ForwardList<T, Alloc>::LinkRangeAfter(Link* link, It first, It last)
     {
-        if (!m_Head)
-            m_Head = new Node(e);
-        else
+        // The new nodes are chained up on their own and only then spliced in, so a throwing copy leaves the
+        // list as it was.
+        Link  head{};
+        Link* tail  = &head;
+        usize count = 0;
+        try
         {
-            auto* current = m_Head;
-            while (current->next)
-                current = current->next;
-            current->next = new Node(e);
+            for (; first != last; ++first, ++count)
+            {
+                tail->next = CreateNode(std::in_place, *first);
+                tail       = tail->next;
+            }
         }
-        ++m_Length;
+        catch (...)
+        {
+            for (Link* current = head.next; current;)
+            {
+                Node* node = AsNode(current);
+                current    = current->next;
+                DestroyNode(node);
+            }
+            throw;
+        }
+        if (count == 0)
+            return link;
+        tail->next = link->next;
+        link->next = head.next;
+        m_Length += count;
+        if (!tail->next)
+            SetLast(tail);
+        return tail;
     }
 
-    template <typename T>
-    inline void ForwardList<T>::PushFront(const T& e)
+    template <typename T, typename Alloc>
+    inline ForwardList<T, Alloc>::Node* ForwardList<T, Alloc>::GetNodeAt(const usize index)
     {
-        if (!m_Head)
-            m_Head = new Node(e);
-        else
+        usize count = 0;
+        for (Link* current = m_Before.next; current; current = current->next)
         {
-            auto* prev   = m_Head;
-            m_Head       = new Node(e);
-            m_Head->next = prev;
+            if (count++ == index)
+                return AsNode(current);
         }
-        ++m_Length;
+
+        return nullptr;
+    }
+
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::Push(const T& e)
+    {
+        EmplaceBack(e);
     }
 
-    template <typename T>
-    inline T& ForwardList<T>::Frost()
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::Push(T&& e)
     {
-        if (!m_Head)
+        EmplaceBack(std::move(e));
+    }
+
+    template <typename T, typename Alloc>
+    template <typename... TArgs>
+    inline T& ForwardList<T, Alloc>::EmplaceBack(TArgs&&... args)
+    {
+        return *EmplaceAfter(ConstIterator(GetLastLink()), std::forward<TArgs>(args)...);
+    }
+
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::PushFront(const T& e)
+    {
+        EmplaceFront(e);
+    }
+
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::PushFront(T&& e)
+    {
+        EmplaceFront(std::move(e));
+    }
+
+    template <typename T, typename Alloc>
+    template <typename... TArgs>
+    inline T& ForwardList<T, Alloc>::EmplaceFront(TArgs&&... args)
+    {
+        return *EmplaceAfter(BeforeBegin(), std::forward<TArgs>(args)...);
+    }
+
+    template <typename T, typename Alloc>
+    inline T& ForwardList<T, Alloc>::Frost()
+    {
+        if (!m_Before.next)
             throw std::out_of_range("Tried caling Front() on an empty List.");
-        return m_Head->obj;
+        return *begin();
     }
 
-    template <typename T>
-    inline const T& ForwardList<T>::Frost() const
+    template <typename T, typename Alloc>
+    inline const T& ForwardList<T, Alloc>::Frost() const
     {
-        if (!m_Head)
+        if (!m_Before.next)
             throw std::out_of_range("Tried caling Front() on an empty List.");
-        return m_Head->obj;
+        return *begin();
     }
 
-    template <typename T>
-    inline void ForwardList<T>::Clear()
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::Clear()
     {
         Drop();
     }
 
-    template <typename T>
-    inline void ForwardList<T>::Resize(const usize newSize)
+    template <typename T, typename Alloc>
+    inline void ForwardList<T, Alloc>::Resize(const usize newSize)
     {
         if (m_Length == newSize)
             return;
 
-        auto prev_two = GetPreviousAndLast();
         if (newSize > m_Length)
         {
-            auto* current = prev_two.second;
-            for (usize i = 0; i < newSize - m_Length; ++i)
-            {
-                current->next = new Node();
-                current       = current->next;
-            }
-            m_Length = newSize;
+            Link* current = GetLastLink();
+            while (m_Length < newSize)
+                current = EmplaceAfter(ConstIterator(current)).m_Link;
         }
-        else if (newSize < m_Length)
+        else
         {
-            for (usize i = 0; i < m_Length - newSize; ++i)
-            {
-                prev_two = GetPreviousAndLast();
-                delete prev_two.second;
-                prev_two.first->next = nullptr;
-            }
-            m_Length = newSize;
+            Link* current = &m_Before;
+            for (usize i = 0; i < newSize; ++i)
+                current = current->next;
+            EraseAfter(ConstIterator(current), end());
         }
     }
 
-    template <typename T>
-    constexpr void ForwardList<T>::Swap(ForwardList<T>& other)
+    template <typename T, typename Alloc>
+    constexpr void ForwardList<T, Alloc>::Swap(ForwardList<T, Alloc>& other)
     {
-        std::swap(m_Head, other.m_Head);
+        m_Pool.Swap(other.m_Pool);
+        std::swap(m_Before.next, other.m_Before.next);
+        std::swap(m_Last, other.m_Last);
         std::swap(m_Length, other.m_Length);
     }
 
-    template <typename T>
-    void ForwardList<T>::Erase(const ConstIterator pos)
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Erase(const ConstIterator pos)
     {
-        if (!Empty())
-        {
-            auto  index    = (pos == end()) ? pos - begin() - 1 : pos - begin();
-            auto* node     = GetNodeAt(index);
-            auto* backward = GetNodeAt(index - 1);
-            auto* forward  = GetNodeAt(index + 1);
-
-            if (backward)
-                if (forward)
-                    backward->next = forward;
-                else
-                    backward->next = nullptr;
-            else
-                m_Head = forward;
-            delete node;
-            --m_Length;
-        }
-        else
+        if (Empty())
             throw std::out_of_range("Tried calling Erase() on an empty vector.");
+
+        // end() stands for the last element.
+        EraseAfter(ConstIterator(GetLinkBefore(pos == end() ? ConstIterator(GetLastLink()) : pos)));
     }
 
-    template <typename T>
-    void ForwardList<T>::Erase(const ConstIterator first, const ConstIterator last)
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Erase(const ConstIterator first, const ConstIterator last)
     {
-        if (!Empty())
-        {
-            const auto start_index = first - begin();
-            const auto len         = last - first + 1;
-            auto*      forward     = GetNodeAt(last - begin() + 1);
-            auto*      backward    = GetNodeAt(first - begin() - 1);
-
-            std::vector<Node*> nodes(len);
-            for (usize i = 0; i < len; ++i)
-                nodes[i] = GetNodeAt(start_index + i);
-
-            if (backward)
-                if (forward)
-                    backward->next = forward;
-                else
-                    backward->next = nullptr;
-            else
-                m_Head = forward;
+        if (Empty())
+            throw std::out_of_range("Tried calling Erase() on an empty list.");
 
-            for (const auto& e : nodes)
-                delete e;
+        EraseAfter(ConstIterator(GetLinkBefore(first)), last == end() ? last : std::next(last));
+    }
 
-            m_Length -= len;
-        }
-        else
-            throw std::out_of_range("Tried calling Erase() on an empty list.");
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Insert(const ConstIterator pos, const T& e)
+    {
+        InsertAfter(ConstIterator(GetLinkBefore(pos)), e);
     }
 
-    template <typename T>
-    void ForwardList<T>::Insert(const ConstIterator pos, const T& e)
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Insert(const ConstIterator pos, const ConstIterator first, const ConstIterator last)
     {
-        const auto index    = pos - begin();
-        auto*      prev     = GetNodeAt(index - 1);
-        auto*      next     = GetNodeAt(index);
-        auto*      new_node = new Node(e);
-        if (!prev)
-            m_Head = new_node;
-        else
-            prev->next = new_node;
-        new_node->next = next;
+        InsertAfter(ConstIterator(GetLinkBefore(pos)), first, last);
+    }
+
+    template <typename T, typename Alloc>
+    typename ForwardList<T, Alloc>::Iterator ForwardList<T, Alloc>::InsertAfter(const ConstIterator pos, const T& e)
+    {
+        return EmplaceAfter(pos, e);
+    }
+
+    template <typename T, typename Alloc>
+    typename ForwardList<T, Alloc>::Iterator ForwardList<T, Alloc>::InsertAfter(const ConstIterator pos, T&& e)
+    {
+        return EmplaceAfter(pos, std::move(e));
+    }
+
+    template <typename T, typename Alloc>
+    template <typename It>
+    typename ForwardList<T, Alloc>::Iterator ForwardList<T, Alloc>::InsertAfter(const ConstIterator pos, It first,
+                                                                                 It last)
+    {
+        return Iterator(LinkRangeAfter(const_cast<Link*>(pos.m_Link), first, last));
+    }
+
+    template <typename T, typename Alloc>
+    template <typename... TArgs>
+    typename ForwardList<T, Alloc>::Iterator ForwardList<T, Alloc>::EmplaceAfter(const ConstIterator pos,
+                                                                                  TArgs&&... args)
+    {
+        Link* link = const_cast<Link*>(pos.m_Link);
+        Node* node = CreateNode(std::in_place, std::forward<TArgs>(args)...);
+        node->next = link->next;
+        link->next = node;
         ++m_Length;
+        if (!node->next)
+            m_Last = node;
+        return Iterator(node);
     }
 
-    template <typename T>
-    void ForwardList<T>::Insert(const ConstIterator pos, const ConstIterator first, const ConstIterator last)
+    template <typename T, typename Alloc>
+    typename ForwardList<T, Alloc>::Iterator ForwardList<T, Alloc>::EraseAfter(const ConstIterator pos)
     {
-        const auto index = pos - begin();
-        const auto len   = last - first;
-        auto*      prev  = GetNodeAt(index - 1);
-        auto*      next  = GetNodeAt(index);
+        Link* link = const_cast<Link*>(pos.m_Link);
+        Node* node = AsNode(link->next);
+        link->next = node->next;
+        DestroyNode(node);
+        --m_Length;
+        if (!link->next)
+            SetLast(link);
+        return Iterator(link->next);
+    }
 
-        if (!prev)
+    template <typename T, typename Alloc>
+    typename ForwardList<T, Alloc>::Iterator ForwardList<T, Alloc>::EraseAfter(const ConstIterator first,
+                                                                                const ConstIterator last)
+    {
+        Link* link = const_cast<Link*>(first.m_Link);
+        Link* stop = const_cast<Link*>(last.m_Link);
+        for (Link* current = link->next; current != stop;)
         {
-            auto* new_head = new Node(*first);
-            auto* current  = new_head;
-            for (auto it = first + 1; it != last; ++it)
-            {
-                current->next = new Node(*it);
-                current       = current->next;
-            }
-            m_Head        = new_head;
-            current->next = next;
+            Node* node = AsNode(current);
+            current    = current->next;
+            DestroyNode(node);
+            --m_Length;
         }
-        else
+        link->next = stop;
+        if (!stop)
+            SetLast(link);
+        return Iterator(stop);
+    }
+
+    template <typename T, typename Alloc>
+    template <typename It>
+    void ForwardList<T, Alloc>::Append(It first, It last)
+    {
+        LinkRangeAfter(GetLastLink(), first, last);
+    }
+
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Append(const std::initializer_list<T> list)
+    {
+        LinkRangeAfter(GetLastLink(), list.begin(), list.end());
+    }
+
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::SpliceAfter(const ConstIterator pos, ForwardList<T, Alloc>& other)
+    {
+        if (&other == this || other.Empty())
+            return;
+
+        Link* link = const_cast<Link*>(pos.m_Link);
+        if (!CanAdopt(other))
         {
-            auto* current = prev;
-            for (auto it = first; it != last; ++it)
+            // Each element leaves other as soon as it is over here, so a throw leaves it in exactly one list.
+            while (other.m_Before.next)
             {
-                current->next = new Node(*it);
-                current       = current->next;
+                link = EmplaceAfter(ConstIterator(link), std::move(AsNode(other.m_Before.next)->obj)).m_Link;
+                other.EraseAfter(other.BeforeBegin());
             }
-            current->next = next;
+            other.Drop();
+            return;
         }
-        m_Length += len;
+
+        m_Pool.Splice(other.m_Pool);
+        Node* last = other.m_Last;
+        last->next = link->next;
+        link->next = other.m_Before.next;
+        if (!last->next)
+            m_Last = last;
+        m_Length += other.m_Length;
+
+        other.m_Before.next = nullptr;
+        other.m_Last        = nullptr;
+        other.m_Length      = 0;
     }
 
-    template <typename T>
-    void ForwardList<T>::Reverse()
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Splice(ForwardList<T, Alloc>& other)
     {
-        Node* current = m_Head;
-        Node* prev    = nullptr;
-        Node* next    = current->next;
+        SpliceAfter(ConstIterator(GetLastLink()), other);
+    }
+
+    template <typename T, typename Alloc>
+    void ForwardList<T, Alloc>::Reverse()
+    {
+        // The first node ends up last.
+        m_Last        = AsNode(m_Before.next);
+        Link* current = m_Before.next;
+        Link* prev    = nullptr;
         while (current)
         {
-            next          = current->next;
+            Link* next    = current->next;
             current->next = prev;
             prev          = current;
             current       = next;
         }
-        m_Head = prev;
+        m_Before.next = prev;
     }
 
-    template <typename T>
-    void ForwardList<T>::Sort()
+    template <typename T, typename Alloc>
+    template <typename Compare, typename Proj>
+    bool ForwardList<T, Alloc>::MergeRuns(Link*& a, Link*& b, Compare& cmp, Proj& proj)
     {
-        for (auto i = 0; i < m_Length; ++i)
+        Link  head{};
+        Link* tail = &head;
+        try
         {
-            auto  j    = 0;
-            auto* prev = m_Head;
-            for (auto* d = m_Head; d && j < m_Length - i; d = d->next, ++j)
+            while (a && b)
             {
-                auto* n = d->next;
-                if (!n)
-                    break;
-                if (d->obj > n->obj)
+                // Takes from a on ties, which is what makes the merge stable.
+                if (std::invoke(cmp, std::invoke(proj, AsNode(b)->obj), std::invoke(proj, AsNode(a)->obj)))
                 {
-                    d->next = n->next;
-                    n->next = d;
-                    if (m_Head == d)
-                        m_Head = n;
-                    else
-                        prev->next = n;
+                    tail->next = b;
+                    b          = b->next;
                 }
-                prev = d;
+                else
+                {
+                    tail->next = a;
+                    a          = a->next;
+                }
+                tail = tail->next;
             }
         }
+        catch (...)
+        {
+            tail->next = a;
+            a          = head.next;
+            throw;
+        }
+
+        const bool endsWithB = !a;
+        tail->next           = a ? a : b;
+        a                    = head.next;
+        b                    = nullptr;
+        return endsWithB;
     }
 
-    template <typename T>
-    inline T& ForwardList<T>::operator[](const usize index) noexcept
+    template <typename T, typename Alloc>
+    template <typename Compare, typename Proj>
+    void ForwardList<T, Alloc>::Sort(Compare cmp, Proj proj)
     {
-        return GetNodeAt(index)->obj;
+        // Bottom-up: bins[i] holds a sorted run of 2^i nodes or nothing. Every node is merged into the bins like
+        // a carry propagating through a binary counter, then the bins are merged from the smallest up. Higher
+        // bins hold earlier nodes, so they always go in as the first run.
+        Link* bins[std::numeric_limits<usize>::digits]{};
+        usize top  = 0;
+        Link* run  = nullptr;
+        Link* rest = std::exchange(m_Before.next, nullptr);
+        try
+        {
+            while (rest)
+            {
+                run       = rest;
+                rest      = rest->next;
+                run->next = nullptr;
+
+                usize i = 0;
+                for (; i < top && bins[i]; ++i)
+                {
+                    MergeRuns(bins[i], run, cmp, proj);
+                    run = std::exchange(bins[i], nullptr);
+                }
+                if (i == top)
+                    ++top;
+                bins[i] = std::exchange(run, nullptr);
+            }
+            for (usize i = 0; i < top; ++i)
+            {
+                if (!bins[i])
+                    continue;
+                MergeRuns(bins[i], run, cmp, proj);
+                run = std::exchange(bins[i], nullptr);
+            }
+        }
+        catch (...)
+        {
+            // Puts every node back, in whatever order they are in by now.
+            Link* link = &m_Before;
+            for (Link* chain : bins)
+                for (link->next = chain; link->next; link = link->next) {}
+            for (link->next = run; link->next; link = link->next) {}
+            link->next = rest;
+            SetLast(GetLinkBefore(end()));
+            throw;
+        }
+
+        m_Before.next = run;
+        SetLast(GetLinkBefore(end()));
     }
 
-    template <typename T>
-    inline ForwardList<T>& ForwardList<T>::operator=(const ForwardList<T>& other)
+    template <typename T, typename Alloc>
+    template <typename Compare, typename Proj>
+    void ForwardList<T, Alloc>::Merge(ForwardList<T, Alloc>& other, Compare cmp, Proj proj)
     {
-        if (&other == this || !other.m_Head)
-            return *this;
+        if (&other == this || other.Empty())
+            return;
 
-        if (m_Head)
-            Drop();
+        if (!CanAdopt(other))
+        {
+            Link* link = &m_Before;
+            while (other.m_Before.next)
+            {
+                T& obj = AsNode(other.m_Before.next)->obj;
+                while (link->next &&
+                       !std::invoke(cmp, std::invoke(proj, obj), std::invoke(proj, AsNode(link->next)->obj)))
+                    link = link->next;
+                link = EmplaceAfter(ConstIterator(link), std::move(obj)).m_Link;
+                other.EraseAfter(other.BeforeBegin());
+            }
+            other.Drop();
+            return;
+        }
 
-        m_Head             = new Node(other.m_Head->obj);
-        m_Length           = other.m_Length;
-        auto* current      = other.m_Head->next;
-        auto* this_current = m_Head;
-        while (current)
+        m_Pool.Splice(other.m_Pool);
+        Node* ourLast   = m_Last;
+        Node* otherLast = std::exchange(other.m_Last, nullptr);
+        Link* a         = m_Before.next;
+        Link* b         = std::exchange(other.m_Before.next, nullptr);
+        m_Length += std::exchange(other.m_Length, 0);
+        try
+        {
+            m_Last = MergeRuns(a, b, cmp, proj) ? otherLast : ourLast;
+            m_Before.next = a;
+        }
+        catch (...)
         {
-            this_current->next = new Node(current->obj);
-            current            = current->next;
-            this_current       = this_current->next;
+            m_Before.next = a;
+            Link* link    = &m_Before;
+            while (link->next)
+                link = link->next;
+            link->next = b;
+            SetLast(b ? otherLast : link);
+            throw;
         }
+    }
 
+    template <typename T, typename Alloc>
+    template <typename Pred>
+    usize ForwardList<T, Alloc>::Unique(Pred pred)
+    {
+        usize removed = 0;
+        Link* link    = m_Before.next;
+        while (link && link->next)
+        {
+            if (std::invoke(pred, AsNode(link)->obj, AsNode(link->next)->obj))
+            {
+                EraseAfter(ConstIterator(link));
+                ++removed;
+            }
+            else
+                link = link->next;
+        }
+        return removed;
+    }
+
+    template <typename T, typename Alloc>
+    inline T& ForwardList<T, Alloc>::operator[](const usize index) noexcept
+    {
+        return GetNodeAt(index)->obj;
+    }
+
+    template <typename T, typename Alloc>
+    inline ForwardList<T, Alloc>& ForwardList<T, Alloc>::operator=(const ForwardList<T, Alloc>& other)
+    {
+        if (&other == this)
+            return *this;
+
+        Drop();
+        if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value)
+            m_Pool.Reset(other.m_Pool.GetAllocator());
+
+        LinkRangeAfter(&m_Before, other.begin(), other.end());
         return *this;
     }
 
-    template <typename T>
-    inline ForwardList<T>& ForwardList<T>::operator=(ForwardList<T>&& other) noexcept
+    template <typename T, typename Alloc>
+    inline ForwardList<T, Alloc>& ForwardList<T, Alloc>::operator=(ForwardList<T, Alloc>&& other) noexcept(
+        NodeAllocTraits::propagate_on_container_move_assignment::value || NodeAllocTraits::is_always_equal::value)
     {
         if (&other == this)
             return *this;
 
-        if (m_Head)
-            Drop();
+        Drop();
+        if constexpr (!NodeAllocTraits::propagate_on_container_move_assignment::value &&
+                      !NodeAllocTraits::is_always_equal::value)
+        {
+            // The nodes belong to a different memory resource, so they have to be recreated one by one.
+            if (m_Pool.GetAllocator() != other.m_Pool.GetAllocator())
+            {
+                Link* tail = &m_Before;
+                for (auto& obj : other)
+                    tail = EmplaceAfter(ConstIterator(tail), std::move(obj)).m_Link;
+                other.Drop();
+                return *this;
+            }
+        }
 
-        m_Head         = other.m_Head;
-        m_Length       = other.m_Length;
-        other.m_Head   = nullptr;
-        other.m_Length = 0;
+        m_Pool        = std::move(other.m_Pool);
+        m_Before.next = std::exchange(other.m_Before.next, nullptr);
+        m_Last        = std::exchange(other.m_Last, nullptr);
+        m_Length      = std::exchange(other.m_Length, 0);
         return *this;
     }
 
-    template <typename T>
-    inline T ForwardList<T>::Pop()
+    template <typename T, typename Alloc>
+    inline T ForwardList<T, Alloc>::Pop()
     {
-        auto prev_two = GetPreviousAndLast();
-        auto obj      = std::move(prev_two.first);
-        delete prev_two.second;
-        prev_two.first->next = nullptr;
-        --m_Length;
-        return std::move(obj);
+        if (!m_Before.next)
+            throw std::out_of_range("Tried calling Pop() on an empty List.");
+
+        // Still a walk, the node before the last one is only known to its own predecessor.
+        Link* prev = GetLinkBefore(ConstIterator(m_Last));
+        auto  obj  = std::move(AsNode(prev->next)->obj);
+        EraseAfter(ConstIterator(prev));
+        return obj;
     }
 
-    template <typename T>
-    inline T ForwardList<T>::PopFront()
+    template <typename T, typename Alloc>
+    inline T ForwardList<T, Alloc>::PopFront()
     {
-        auto  obj = std::move(m_Head->obj);
-        auto* t   = m_Head;
-        m_Head    = m_Head->next;
-        delete t;
-        --m_Length;
-        return std::move(obj);
+        auto obj = std::move(*begin());
+        EraseAfter(BeforeBegin());
+        return obj;
     }
 } // namespace my
 
@@ -0,0 +1,107 @@
+#ifndef MY_CONCURRENT_HASH_MAP_H
+#define MY_CONCURRENT_HASH_MAP_H
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+
+#include <CommonDef.h>
+
+#include "HashMap.h"
+
+namespace my {
+    // A thread safe hash map that splits its keys across a power of two number of shards, each being a HashMap
+    // behind its own reader-writer lock. The shard is picked from the top bits of the key's hash, which the
+    // shard's HashMap then reuses through its *WithHash() functions, so every key is hashed once. Readers of
+    // the same shard never block each other and threads working on different shards never touch the same lock.
+    //
+    // Values are handed out as copies (or through Visit() while the lock is held) since a reference into a
+    // shard would not outlive the lock that protects it.
+    template <typename T, typename U, typename Hasher = Hash<T>, typename KeyEqual = std::equal_to<>,
+              typename Alloc = Allocator<Pair<T, U>>>
+        requires HasEqualsOperator<T> && HasHashFunction<T>
+    class ConcurrentHashMap
+    {
+    public:
+        using Map = HashMap<T, U, Hasher, KeyEqual, Alloc>;
+
+    private:
+        // Shards are padded out to their own cache lines so that taking one lock does not invalidate the
+        // line of its neighbour.
+        struct alignas(64) Shard
+        {
+            mutable std::shared_mutex mutex;
+            Map                       map;
+
+        public:
+            Shard(const Hasher& hash, const KeyEqual& keyEqual, const Alloc& allocator)
+                : map(hash, keyEqual, allocator)
+            {
+            }
+        };
+
+        static constexpr bool IsTransparent =
+            requires { typename Hasher::is_transparent; } && requires { typename KeyEqual::is_transparent; };
+
+        template <typename K>
+        using KeyArg = typename KeyArgOf<IsTransparent>::template Type<K, T>;
+
+    private:
+        Shard* m_Shards     = nullptr;
+        usize  m_ShardCount = 0;
+        usize  m_ShardShift = 0;
+
+    public:
+        explicit ConcurrentHashMap(const usize shardCount = DefaultShardCount(), const Hasher& hash = Hasher(),
+                                   const KeyEqual& keyEqual = KeyEqual(), const Alloc& allocator = Alloc());
+        ConcurrentHashMap(const ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>&) = delete;
+        ConcurrentHashMap(ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>&&)      = delete;
+        ~ConcurrentHashMap() noexcept;
+
+    public:
+        // Four shards per hardware thread keeps the chance of two threads hitting the same shard low.
+        static usize DefaultShardCount() noexcept;
+
+    private:
+        Shard& ShardFor(const usize hash) const noexcept;
+
+    public:
+        constexpr usize ShardCount() const noexcept { return m_ShardCount; }
+
+    public:
+        bool             Insert(const T& key, const U& value);
+        template <typename K = T>
+        std::optional<U> Find(const KeyArg<K>& key) const;
+        template <typename K = T>
+        U                At(const KeyArg<K>& key) const;
+        template <typename K = T>
+        bool             Erase(const KeyArg<K>& key);
+        template <typename K = T>
+        bool             ContainsKey(const KeyArg<K>& key) const;
+        // Calls func with a const reference to the value of key while its shard is locked for reading,
+        // returns false if there is no such key.
+        template <typename K = T, typename Func>
+        bool             Visit(const KeyArg<K>& key, Func&& func) const;
+        // Same as Visit() but locks the shard for writing and hands func a mutable reference.
+        template <typename K = T, typename Func>
+        bool             Modify(const KeyArg<K>& key, Func&& func);
+        // Size() and Empty() lock one shard at a time, so under concurrent writes they are only a snapshot.
+        usize            Size() const;
+        bool             Empty() const;
+        void             Clear();
+        void             Reserve(const usize count);
+
+    public:
+        ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>& operator=(
+            const ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>&) = delete;
+        ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>& operator=(
+            ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>&&) = delete;
+    };
+} // namespace my
+
+#include "ConcurrentHashMap.hpp"
+
+#endif // MY_CONCURRENT_HASH_MAP_H
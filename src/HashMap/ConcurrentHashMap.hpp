@@ -0,0 +1,194 @@
+#ifndef MY_CONCURRENT_HASH_MAP_IMPL_HPP
+#define MY_CONCURRENT_HASH_MAP_IMPL_HPP
+
+#include <bit>
+#include <limits>
+#include <stdexcept>
+
+#define CONCURRENT_HASHMAP_TEMPLATE_DECL()                                                                             \
+    template <typename T, typename U, typename Hasher, typename KeyEqual, typename Alloc>                              \
+        requires HasEqualsOperator<T> && HasHashFunction<T>
+
+namespace my {
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::ConcurrentHashMap(const usize shardCount, const Hasher& hash,
+                                                                        const KeyEqual& keyEqual,
+                                                                        const Alloc&    allocator)
+        : m_ShardCount(std::bit_ceil(std::max<usize>(shardCount, 1)))
+    {
+        // The shards are built in place since neither the locks nor the maps (their allocator might not
+        // propagate) can be assigned afterwards.
+        m_Shards =
+            static_cast<Shard*>(::operator new(sizeof(Shard) * m_ShardCount, std::align_val_t{ alignof(Shard) }));
+        usize i = 0;
+        try
+        {
+            for (; i < m_ShardCount; ++i)
+                std::construct_at(m_Shards + i, hash, keyEqual, allocator);
+        }
+        catch (...)
+        {
+            std::destroy_n(m_Shards, i);
+            ::operator delete(m_Shards, std::align_val_t{ alignof(Shard) });
+            throw;
+        }
+
+        // The shard index comes from the top bits of the hash, the maps themselves index with the lower ones.
+        m_ShardShift = m_ShardCount > 1 ? std::numeric_limits<usize>::digits - std::countr_zero(m_ShardCount) : 0;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::~ConcurrentHashMap() noexcept
+    {
+        std::destroy_n(m_Shards, m_ShardCount);
+        ::operator delete(m_Shards, std::align_val_t{ alignof(Shard) });
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    usize ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::DefaultShardCount() noexcept
+    {
+        return std::bit_ceil(std::max<usize>(std::thread::hardware_concurrency(), 1) * 4);
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    typename ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Shard& ConcurrentHashMap<
+        T, U, Hasher, KeyEqual, Alloc>::ShardFor(const usize hash) const noexcept
+    {
+        return m_Shards[(hash >> m_ShardShift) & (m_ShardCount - 1)];
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    bool ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Insert(const T& key, const U& value)
+    {
+        // Every shard uses the same hasher, and it is never modified, so any of them can do the hashing.
+        const usize hash  = m_Shards[0].map.HashOf(key);
+        auto&       shard = ShardFor(hash);
+
+        std::unique_lock lock(shard.mutex);
+        return shard.map.InsertWithHash(hash, key, value);
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    std::optional<U> ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Find(const KeyArg<K>& key) const
+    {
+        const usize hash  = m_Shards[0].map.template HashOf<K>(key);
+        const auto& shard = ShardFor(hash);
+
+        std::shared_lock lock(shard.mutex);
+        if (const U* value = shard.map.template FindWithHash<K>(hash, key))
+            return *value;
+        return std::nullopt;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    U ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::At(const KeyArg<K>& key) const
+    {
+        std::optional<U> value = Find<K>(key);
+        if (!value)
+            throw std::invalid_argument("It does not exist.");
+        return std::move(*value);
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    bool ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Erase(const KeyArg<K>& key)
+    {
+        auto& shard = ShardFor(m_Shards[0].map.template HashOf<K>(key));
+
+        std::unique_lock lock(shard.mutex);
+        return shard.map.template Erase<K>(key);
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    bool ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::ContainsKey(const KeyArg<K>& key) const
+    {
+        const usize hash  = m_Shards[0].map.template HashOf<K>(key);
+        const auto& shard = ShardFor(hash);
+
+        std::shared_lock lock(shard.mutex);
+        return shard.map.template FindWithHash<K>(hash, key) != nullptr;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    template <typename K, typename Func>
+    bool ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Visit(const KeyArg<K>& key, Func&& func) const
+    {
+        const usize hash  = m_Shards[0].map.template HashOf<K>(key);
+        const auto& shard = ShardFor(hash);
+
+        std::shared_lock lock(shard.mutex);
+        const U*         value = shard.map.template FindWithHash<K>(hash, key);
+        if (!value)
+            return false;
+        std::forward<Func>(func)(*value);
+        return true;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    template <typename K, typename Func>
+    bool ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Modify(const KeyArg<K>& key, Func&& func)
+    {
+        const usize hash  = m_Shards[0].map.template HashOf<K>(key);
+        auto&       shard = ShardFor(hash);
+
+        std::unique_lock lock(shard.mutex);
+        U*               value = shard.map.template FindWithHash<K>(hash, key);
+        if (!value)
+            return false;
+        std::forward<Func>(func)(*value);
+        return true;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    usize ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Size() const
+    {
+        usize size = 0;
+        for (usize i = 0; i < m_ShardCount; ++i)
+        {
+            std::shared_lock lock(m_Shards[i].mutex);
+            size += m_Shards[i].map.Size();
+        }
+        return size;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    bool ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Empty() const
+    {
+        for (usize i = 0; i < m_ShardCount; ++i)
+        {
+            std::shared_lock lock(m_Shards[i].mutex);
+            if (!m_Shards[i].map.Empty())
+                return false;
+        }
+        return true;
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    void ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Clear()
+    {
+        for (usize i = 0; i < m_ShardCount; ++i)
+        {
+            std::unique_lock lock(m_Shards[i].mutex);
+            m_Shards[i].map.Clear();
+        }
+    }
+
+    CONCURRENT_HASHMAP_TEMPLATE_DECL()
+    void ConcurrentHashMap<T, U, Hasher, KeyEqual, Alloc>::Reserve(const usize count)
+    {
+        // Assumes the keys spread evenly, with a little headroom for the shards that get more than their share.
+        const usize per_shard = count / m_ShardCount + count / m_ShardCount / 8 + 1;
+        for (usize i = 0; i < m_ShardCount; ++i)
+        {
+            std::unique_lock lock(m_Shards[i].mutex);
+            m_Shards[i].map.Reserve(per_shard);
+        }
+    }
+} // namespace my
+
+#undef CONCURRENT_HASHMAP_TEMPLATE_DECL
+
+#endif // MY_CONCURRENT_HASH_MAP_IMPL_HPP
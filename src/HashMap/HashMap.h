@@ -1,17 +1,31 @@
 #ifndef MY_HASH_MAP_H
 #define MY_HASH_MAP_H
 
+#include <algorithm>
+#include <bit>
 #include <concepts>
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
 
 #include <CommonDef.h>
 
-#include "../ForwardList/ForwardList.h"
+#include "../Memory/Allocator.h"
 #include "../Vector/Vector.h"
+#include "Utilities/ControlGroup.h"
+#include "Utilities/Hash.h"
+#include "Utilities/KeyArg.h"
 #include "Utilities/Pair.h"
+#include "Utilities/Snapshot.h"
 
 namespace my {
 
@@ -29,57 +43,389 @@ namespace my {
     template <typename T>
     concept HasHashFunction = requires { typename std::hash<T>; };
 
-    template <typename T, typename U>
+    template <typename T, typename U, typename Hasher, typename KeyEqual>
+    class MappedHashMap;
+
+    // An open addressing hash map in the style of Swiss tables. The pairs live directly inside one flat array
+    // of slots next to an array of one byte control words (see ControlGroup), lookups probe the control bytes
+    // a group at a time and only touch the slots whose control byte matches the key's hash.
+    template <typename T, typename U, typename Hasher = Hash<T>, typename KeyEqual = std::equal_to<>,
+              typename Alloc = Allocator<Pair<T, U>>>
         requires HasEqualsOperator<T> && HasHashFunction<T>
     class HashMap
     {
+        template <typename, typename, typename, typename>
+        friend class MappedHashMap;
+
+    public:
+        static constexpr usize InitialBucketSize    = ControlGroup::Width;
+        static constexpr f32   DefaultMaxLoadFactor = 0.875f;
+        // Open addressing needs some empty slots to terminate probes, so the load factor is clamped to this.
+        static constexpr f32   MinMaxLoadFactor     = 0.25f;
+        static constexpr f32   MaxMaxLoadFactor     = 0.9375f;
+        // FindBatch() hashes and prefetches this many keys ahead of resolving them.
+        static constexpr usize BatchSize            = 16;
+
+    private:
+        // Every slot keeps the (mixed) hash of its key next to the pair, so growing the table never has to
+        // call the hasher again and most mismatching keys are rejected without being compared.
+        struct Slot
+        {
+            usize hash;
+            // The same pair seen two ways, like libc++ and Abseil do for their maps: the table builds and moves
+            // pair, the iterators hand out value, whose key cannot be changed behind the table's back.
+            union
+            {
+                my::Pair<T, U>       pair;
+                my::Pair<const T, U> value;
+            };
+
+        public:
+            template <typename... TArgs>
+            explicit Slot(const usize hash, TArgs&&... args) : hash(hash), pair(std::forward<TArgs>(args)...)
+            {
+            }
+            // Trivial whenever the Pair is, so slots of plain data can still be copied around as bytes.
+            Slot(const Slot&)
+                requires std::is_trivially_copy_constructible_v<my::Pair<T, U>>
+            = default;
+            Slot(const Slot& other) : hash(other.hash), pair(other.pair) {}
+            Slot(Slot&&)
+                requires std::is_trivially_move_constructible_v<my::Pair<T, U>>
+            = default;
+            Slot(Slot&& other) noexcept(std::is_nothrow_move_constructible_v<my::Pair<T, U>>)
+                : hash(other.hash), pair(std::move(other.pair))
+            {
+            }
+            ~Slot()
+                requires std::is_trivially_destructible_v<my::Pair<T, U>>
+            = default;
+            ~Slot() { pair.~Pair(); }
+        };
+
+        using SlotAllocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+        using SlotAllocTraits = std::allocator_traits<SlotAllocator>;
+        using CtrlAllocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<i8>;
+        using CtrlAllocTraits = std::allocator_traits<CtrlAllocator>;
+
+        static constexpr bool IsTransparent =
+            requires { typename Hasher::is_transparent; } && requires { typename KeyEqual::is_transparent; };
+
+        // Lookups accept any key type the hasher and the comparator understand if both of them are transparent,
+        // e.g. std::string_view or const char* for std::string keys, so no temporary key has to be built.
+        template <typename K>
+        using KeyArg = typename KeyArgOf<IsTransparent>::template Type<K, T>;
+
+        template <bool Const>
+        using SlotRef = std::conditional_t<Const, const Slot&, Slot&>;
+
+        // What the iterators hand out for a slot. Keys are never given out mutably, so the map itself yields
+        // the stored pair with its key made const.
+        template <bool Const>
+        struct PairProjection
+        {
+            using value_type = Pair<T, U>;
+            using reference  = std::conditional_t<Const, const Pair<const T, U>&, Pair<const T, U>&>;
+
+            static reference Get(SlotRef<Const> slot) noexcept { return slot.value; }
+        };
+
+        template <bool Const>
+        struct KeyProjection
+        {
+            using value_type = T;
+            using reference  = const T&;
+
+            static reference Get(SlotRef<Const> slot) noexcept { return slot.pair.first; }
+        };
+
+        template <bool Const>
+        struct ValueProjection
+        {
+            using value_type = U;
+            using reference  = std::conditional_t<Const, const U&, U&>;
+
+            static reference Get(SlotRef<Const> slot) noexcept { return slot.pair.second; }
+        };
+
+        // Walks the full slots in table order, skipping a whole group of control bytes at a time when it holds
+        // none. Any insertion may rehash and invalidate every iterator, erasing only invalidates the erased one.
+        template <bool Const, template <bool> typename Projection>
+        class BasicIterator
+        {
+            template <bool, template <bool> typename>
+            friend class BasicIterator;
+            friend class HashMap;
+            template <typename, typename, typename, typename>
+            friend class MappedHashMap;
+
+            using SlotPointer = std::conditional_t<Const, const Slot*, Slot*>;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using difference_type   = ptrdiff;
+            using value_type        = typename Projection<Const>::value_type;
+            using reference         = typename Projection<Const>::reference;
+
+        private:
+            const i8*   m_Control  = nullptr;
+            SlotPointer m_Slots    = nullptr;
+            usize       m_Index    = 0;
+            usize       m_Capacity = 0;
+
+        private:
+            BasicIterator(const i8* control, SlotPointer slots, const usize index, const usize capacity) noexcept
+                : m_Control(control), m_Slots(slots), m_Index(index), m_Capacity(capacity)
+            {
+                SkipToFull();
+            }
+
+        public:
+            BasicIterator() noexcept = default;
+            template <bool OtherConst>
+                requires(Const && !OtherConst)
+            BasicIterator(const BasicIterator<OtherConst, Projection>& other) noexcept
+                : m_Control(other.m_Control), m_Slots(other.m_Slots), m_Index(other.m_Index),
+                  m_Capacity(other.m_Capacity)
+            {
+            }
+
+        private:
+            void SkipToFull() noexcept
+            {
+                // The cloned control bytes past the end may report full slots, those land beyond m_Capacity.
+                while (m_Index < m_Capacity)
+                {
+                    const u32 full = ControlGroup(m_Control + m_Index).MatchFull();
+                    if (full)
+                    {
+                        m_Index = std::min<usize>(m_Index + std::countr_zero(full), m_Capacity);
+                        return;
+                    }
+                    m_Index += ControlGroup::Width;
+                }
+                m_Index = m_Capacity;
+            }
+
+        public:
+            reference operator*() const noexcept { return Projection<Const>::Get(m_Slots[m_Index]); }
+            auto      operator->() const noexcept { return std::addressof(**this); }
+            BasicIterator& operator++() noexcept
+            {
+                ++m_Index;
+                SkipToFull();
+                return *this;
+            }
+            BasicIterator operator++(const i32) noexcept
+            {
+                auto t = *this;
+                ++(*this);
+                return t;
+            }
+
+        public:
+            friend bool operator==(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
+            {
+                return lhv.m_Slots == rhv.m_Slots && lhv.m_Index == rhv.m_Index;
+            }
+            friend bool operator!=(const BasicIterator& lhv, const BasicIterator& rhv) noexcept
+            {
+                return !(lhv == rhv);
+            }
+        };
+
     public:
-        static constexpr usize InitialBucketSize = 3;
+        using Iterator           = BasicIterator<false, PairProjection>;
+        using ConstIterator      = BasicIterator<true, PairProjection>;
+        using KeyIterator        = BasicIterator<true, KeyProjection>;
+        using ValueIterator      = BasicIterator<false, ValueProjection>;
+        using ConstValueIterator = BasicIterator<true, ValueProjection>;
+
+        // A non owning range over the keys or the values of the map, valid as long as its iterators are.
+        template <typename It>
+        class View
+        {
+        private:
+            It    m_Begin;
+            It    m_End;
+            usize m_Size;
+
+        public:
+            View(const It begin, const It end, const usize size) noexcept : m_Begin(begin), m_End(end), m_Size(size)
+            {
+            }
+
+        public:
+            constexpr It    begin() const noexcept { return m_Begin; }
+            constexpr It    end() const noexcept { return m_End; }
+            constexpr usize Size() const noexcept { return m_Size; }
+            constexpr bool  Empty() const noexcept { return m_Size == 0; }
+        };
 
     private:
-        my::Vec<my::ForwardList<my::Pair<T, U>>> m_Table{};
-        usize                                    m_Size        = HashMap<T, U>::InitialBucketSize;
-        usize                                    m_MaxListSize = 0;
+        [[no_unique_address]] SlotAllocator m_Allocator{};
+        [[no_unique_address]] Hasher        m_Hash{};
+        [[no_unique_address]] KeyEqual      m_KeyEqual{};
+        i8*                                 m_Control        = nullptr;
+        Slot*                               m_Slots          = nullptr;
+        usize                               m_Capacity       = 0;
+        usize                               m_Size           = 0;
+        usize                               m_GrowthLeft     = 0;
+        usize                               m_MaxProbeLength = 0;
+        f32                                 m_MaxLoadFactor  = DefaultMaxLoadFactor;
 
     public:
-        HashMap();
+        HashMap() noexcept;
+        explicit HashMap(const Alloc& allocator) noexcept;
+        explicit HashMap(const Hasher& hash, const KeyEqual& keyEqual = KeyEqual(), const Alloc& allocator = Alloc());
+        HashMap(const HashMap<T, U, Hasher, KeyEqual, Alloc>& other);
+        HashMap(HashMap<T, U, Hasher, KeyEqual, Alloc>&& other) noexcept;
+        ~HashMap() noexcept;
+
+    private:
+        static constexpr usize Mix(const usize hash) noexcept;
+        static constexpr usize H1(const usize hash) noexcept { return hash >> 7; }
+        static constexpr i8    H2(const usize hash) noexcept { return static_cast<i8>(hash & 0x7F); }
+        static void            Prefetch(const void* address) noexcept;
+        usize                  CapacityToGrowth(const usize capacity) const noexcept;
+        usize                  CapacityFor(const usize count) const noexcept;
+
+    private:
+        void  Allocate(const usize capacity);
+        void  Deallocate() noexcept;
+        void  Drop() noexcept;
+        void  DestroySlots() noexcept;
+        void  CopyFrom(const HashMap<T, U, Hasher, KeyEqual, Alloc>& other);
+        void  StealFrom(HashMap<T, U, Hasher, KeyEqual, Alloc>& other) noexcept;
+        void  SetControl(const usize index, const i8 control) noexcept;
+        template <typename K>
+        usize FindIndex(const K& key, const usize hash) const noexcept;
+        // The probe behind FindIndex(), on its own so that MappedHashMap can run it over a mapped table.
+        template <typename K>
+        static usize Probe(const i8* control, const Slot* slots, const usize capacity, const KeyEqual& keyEqual,
+                           const K& key, const usize hash) noexcept;
+        usize FindFirstNonFull(const usize hash) noexcept;
+        usize PrepareInsert(const usize hash);
+        template <typename K, typename... TArgs>
+        std::pair<U*, bool> TryEmplaceWithHash(const usize hash, K&& key, TArgs&&... args);
+        void  Grow();
+        void  Resize(const usize newCapacity);
+        void  EraseAt(const usize index) noexcept;
 
     public:
+        // Insert() overwrites the value of a key that is already there and returns whether it was.
         bool                  Insert(const T& key, const U& value);
-        U&                    At(const T& key);
-        bool                  Erase(const T& key);
-        bool                  ContainsKey(const T& key) const noexcept;
+        bool                  Insert(T&& key, U&& value);
+        // The functions below return the value of the key and whether it was inserted. TryEmplace() builds the
+        // value from args in place and leaves both untouched if the key exists, InsertOrAssign() assigns to
+        // the existing value instead. Emplace() has to build the whole pair before it can hash its key.
+        template <typename... TArgs>
+        std::pair<U*, bool>   Emplace(TArgs&&... args);
+        template <typename... TArgs>
+        std::pair<U*, bool>   TryEmplace(const T& key, TArgs&&... args);
+        template <typename... TArgs>
+        std::pair<U*, bool>   TryEmplace(T&& key, TArgs&&... args);
+        template <typename V>
+        std::pair<U*, bool>   InsertOrAssign(const T& key, V&& value);
+        template <typename V>
+        std::pair<U*, bool>   InsertOrAssign(T&& key, V&& value);
+        template <typename K = T>
+        usize                 HashOf(const KeyArg<K>& key) const noexcept;
+        // The *WithHash() functions take a hash that came from HashOf() so that callers that already hashed a
+        // key do not pay for it twice, passing anything else leaves the map in an unspecified state.
+        bool                  InsertWithHash(const usize hash, const T& key, const U& value);
+        template <typename K = T>
+        U*                    Find(const KeyArg<K>& key) noexcept;
+        template <typename K = T>
+        const U*              Find(const KeyArg<K>& key) const noexcept;
+        template <typename K = T>
+        U*                    FindWithHash(const usize hash, const KeyArg<K>& key) noexcept;
+        template <typename K = T>
+        const U*              FindWithHash(const usize hash, const KeyArg<K>& key) const noexcept;
+        // Looks up every key and stores a pointer to its value, or nullptr, at the same index of values, then
+        // returns how many were found. Keys are hashed and their groups prefetched BatchSize at a time before
+        // any of them is probed, so the cache misses of a batch overlap instead of being paid one by one.
+        template <typename K = T>
+        usize                 FindBatch(std::span<const KeyArg<K>> keys, std::span<U*> values);
+        template <typename K = T>
+        usize                 FindBatch(std::span<const KeyArg<K>> keys, std::span<const U*> values) const;
+        template <typename K = T>
+        U&                    At(const KeyArg<K>& key);
+        template <typename K = T>
+        bool                  Erase(const KeyArg<K>& key);
+        template <typename K = T>
+        bool                  ContainsKey(const KeyArg<K>& key) const noexcept;
         bool                  ContainsValue(const U& value) const noexcept;
-        usize                 Size() const noexcept;
-        bool                  Empty() const noexcept;
         void                  Clear() noexcept;
+        // Values(), KeySet() and ValueSet() copy, KeysView() and ValuesView() iterate the table in place.
         my::Vec<U>            Values() const noexcept;
         std::unordered_set<T> KeySet() const noexcept;
         std::unordered_set<U> ValueSet() const noexcept;
+        void                  Swap(HashMap<T, U, Hasher, KeyEqual, Alloc>& other) noexcept;
+        void                  Reserve(const usize count);
+        void                  Rehash(const usize bucketCount);
+        f32                   MaxLoadFactor() const noexcept { return m_MaxLoadFactor; }
+        void                  MaxLoadFactor(const f32 loadFactor);
+        constexpr Alloc       GetAllocator() const noexcept { return Alloc(m_Allocator); }
+        constexpr Hasher      HashFunction() const { return m_Hash; }
+        constexpr KeyEqual    KeyEq() const { return m_KeyEqual; }
+        // Writes the table to path in a form MappedHashMap can map and query in place (see SnapshotHeader).
+        // Stored hashes are reused as they are, so the file must be read with the same Hasher.
+        void                  Save(const std::string& path) const
+            requires std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<U>;
 
     public:
-        friend std::ostream& operator<<(std::ostream& stream, const my::HashMap<T, U>& map) noexcept
+        Iterator                 begin() noexcept { return Iterator(m_Control, m_Slots, 0, m_Capacity); }
+        Iterator                 end() noexcept { return Iterator(m_Control, m_Slots, m_Capacity, m_Capacity); }
+        ConstIterator            begin() const noexcept { return cbegin(); }
+        ConstIterator            end() const noexcept { return cend(); }
+        ConstIterator            cbegin() const noexcept { return ConstIterator(m_Control, m_Slots, 0, m_Capacity); }
+        ConstIterator            cend() const noexcept
         {
-            auto it = map.m_Table.cbegin();
-            stream << "{ ";
-            do
-            {
-                if (it == map.m_Table.cend())
-                    break;
+            return ConstIterator(m_Control, m_Slots, m_Capacity, m_Capacity);
+        }
+        View<KeyIterator>        KeysView() const noexcept;
+        View<ValueIterator>      ValuesView() noexcept;
+        View<ConstValueIterator> ValuesView() const noexcept;
 
-                for (const auto& e : *it)
-                    stream << e;
+    public:
+        // Statistics, all of them O(1).
+        constexpr usize Size() const noexcept { return m_Size; }
+        constexpr bool  Empty() const noexcept { return m_Size == 0; }
+        constexpr usize BucketCount() const noexcept { return m_Capacity; }
+        constexpr f32   LoadFactor() const noexcept { return m_Capacity ? f32(m_Size) / f32(m_Capacity) : 0.0f; }
+        // The longest probe sequence, in groups of ControlGroup::Width slots, that any insertion needed since
+        // the table was last rebuilt. Erasing keys does not lower it, so it is an upper bound for lookups.
+        constexpr usize MaxProbeLength() const noexcept { return m_MaxProbeLength; }
 
-                if (it + 1 != map.m_Table.cend())
-                    stream << ", ";
+    public:
+        HashMap<T, U, Hasher, KeyEqual, Alloc>& operator=(const HashMap<T, U, Hasher, KeyEqual, Alloc>& other);
+        HashMap<T, U, Hasher, KeyEqual, Alloc>& operator=(HashMap<T, U, Hasher, KeyEqual, Alloc>&& other) noexcept(
+            SlotAllocTraits::propagate_on_container_move_assignment::value || SlotAllocTraits::is_always_equal::value);
 
-                ++it;
-            } while (true);
+    public:
+        friend std::ostream& operator<<(std::ostream&                                       stream,
+                                        const my::HashMap<T, U, Hasher, KeyEqual, Alloc>& map) noexcept
+        {
+            bool first = true;
+            stream << "{ ";
+            for (const auto pair : map)
+            {
+                if (!first)
+                    stream << ", ";
+                stream << pair;
+                first = false;
+            }
             stream << " }";
             return stream;
         }
     };
 } // namespace my
 
+namespace my::pmr {
+    template <typename T, typename U, typename Hasher = Hash<T>, typename KeyEqual = std::equal_to<>>
+    using HashMap = my::HashMap<T, U, Hasher, KeyEqual, std::pmr::polymorphic_allocator<Pair<T, U>>>;
+} // namespace my::pmr
+
 #include "HashMap.hpp"
 #endif // MY_HASH_MAP_H
@@ -1,201 +1,817 @@
 #ifndef MY_HASH_MAP_IMPL_HPP
 #define MY_HASH_MAP_IMPL_HPP
 
-#include "Utilities/Math.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
 
 #define HASHMAP_TEMPLATE_DECL()                                                                                        \
-    template <typename T, typename U>                                                                                  \
+    template <typename T, typename U, typename Hasher, typename KeyEqual, typename Alloc>                              \
         requires HasEqualsOperator<T> && HasHashFunction<T>
 
 namespace my {
     HASHMAP_TEMPLATE_DECL()
-    HashMap<T, U>::HashMap() : m_Table(HashMap<T, U>::InitialBucketSize)
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::HashMap() noexcept = default;
+
+    HASHMAP_TEMPLATE_DECL()
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::HashMap(const Alloc& allocator) noexcept : m_Allocator(allocator)
     {
     }
 
     HASHMAP_TEMPLATE_DECL()
-    bool HashMap<T, U>::Insert(const T& key, const U& value)
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::HashMap(const Hasher& hash, const KeyEqual& keyEqual,
+                                                    const Alloc& allocator)
+        : m_Allocator(allocator), m_Hash(hash), m_KeyEqual(keyEqual)
     {
-        const auto hash     = std::hash<T>{}(key);
-        const auto hash_idx = hash % m_Size;
+    }
 
-        // Resize and rehash if a any linked lists' size equals to our vector
-		// or our hash is bigger than our current size.
-        if (hash_idx >= m_Size || m_MaxListSize + 1 == m_Table.Size())
+    HASHMAP_TEMPLATE_DECL()
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::HashMap(const HashMap<T, U, Hasher, KeyEqual, Alloc>& other)
+        : m_Allocator(SlotAllocTraits::select_on_container_copy_construction(other.m_Allocator)),
+          m_Hash(other.m_Hash), m_KeyEqual(other.m_KeyEqual), m_MaxLoadFactor(other.m_MaxLoadFactor)
+    {
+        CopyFrom(other);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::HashMap(HashMap<T, U, Hasher, KeyEqual, Alloc>&& other) noexcept
+        : m_Allocator(std::move(other.m_Allocator)), m_Hash(std::move(other.m_Hash)),
+          m_KeyEqual(std::move(other.m_KeyEqual)), m_MaxLoadFactor(other.m_MaxLoadFactor)
+    {
+        StealFrom(other);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::~HashMap() noexcept
+    {
+        Drop();
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    constexpr usize HashMap<T, U, Hasher, KeyEqual, Alloc>::Mix(const usize hash) noexcept
+    {
+        // std::hash is the identity for integers on most standard libraries, which would put consecutive keys
+        // into the same group and leave H2 with next to no entropy, so spread the bits across the whole word.
+        u64 h = static_cast<u64>(hash);
+        h ^= h >> 32;
+        h *= 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+        return static_cast<usize>(h);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::HashOf(const KeyArg<K>& key) const noexcept
+    {
+        return Mix(m_Hash(key));
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::CapacityToGrowth(const usize capacity) const noexcept
+    {
+        // At least one slot always stays empty so that every probe sequence terminates.
+        const auto growth = static_cast<usize>(static_cast<f128>(capacity) * m_MaxLoadFactor);
+        return capacity ? std::min(growth, capacity - 1) : 0;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::CapacityFor(const usize count) const noexcept
+    {
+        // The smallest power of two capacity that holds count elements without exceeding the max load factor.
+        usize capacity = InitialBucketSize;
+        while (CapacityToGrowth(capacity) < count)
+            capacity *= 2;
+        return capacity;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Allocate(const usize capacity)
+    {
+        // The first Width - 1 control bytes are cloned past the end so that a group can be loaded from any
+        // position without wrapping around.
+        CtrlAllocator ctrl_allocator(m_Allocator);
+        m_Control = CtrlAllocTraits::allocate(ctrl_allocator, capacity + ControlGroup::Width - 1);
+        try
         {
-            decltype(m_Table) copy{};
-            copy = std::move(m_Table);
+            m_Slots = SlotAllocTraits::allocate(m_Allocator, capacity);
+        }
+        catch (...)
+        {
+            CtrlAllocTraits::deallocate(ctrl_allocator, m_Control, capacity + ControlGroup::Width - 1);
+            m_Control = nullptr;
+            throw;
+        }
+        std::memset(m_Control, static_cast<u8>(ControlGroup::Empty), capacity + ControlGroup::Width - 1);
+        m_Capacity       = capacity;
+        m_GrowthLeft     = CapacityToGrowth(capacity);
+        m_MaxProbeLength = 0;
+    }
 
-            m_Size  = NextPrime(m_Size);
-            m_Table = decltype(m_Table)(m_Size);
-            for (const auto& e : copy)
-            {
-                if (!e.Empty())
-                {
-                    const auto rehash     = std::hash<T>{}(e.Frost().first);
-                    const auto rehash_idx = rehash % m_Size;
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Deallocate() noexcept
+    {
+        if (m_Control)
+        {
+            CtrlAllocator ctrl_allocator(m_Allocator);
+            CtrlAllocTraits::deallocate(ctrl_allocator, m_Control, m_Capacity + ControlGroup::Width - 1);
+            SlotAllocTraits::deallocate(m_Allocator, m_Slots, m_Capacity);
+        }
+        m_Control        = nullptr;
+        m_Slots          = nullptr;
+        m_Capacity       = 0;
+        m_Size           = 0;
+        m_GrowthLeft     = 0;
+        m_MaxProbeLength = 0;
+    }
 
-                    m_Table[rehash_idx] = std::move(e);
-                }
-            }
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::DestroySlots() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<Slot>)
+        {
+            for (usize i = 0; i < m_Capacity; ++i)
+                if (ControlGroup::IsFull(m_Control[i]))
+                    SlotAllocTraits::destroy(m_Allocator, m_Slots + i);
         }
-		
-		if (!m_Table[hash_idx].Empty())
-		{
-            auto ref = m_Table[hash_idx].end();
-            for (auto it = m_Table[hash_idx].begin(); it != m_Table[hash_idx].end(); ++it)
-			{
-				if ((*it).first == key)
-				{
-                    ref = it;
-					break;
-				}	
-			}
-
-			if (ref != m_Table[hash_idx].end())
-            {
-				(*ref).second = value;
-                return true;
-            }
-		}
-        m_Table[hash_idx].PushFront(my::Pair<T, U>::New(key, value));
-		
-		if (m_MaxListSize < m_Table[hash_idx].Size())
-			m_MaxListSize = m_Table[hash_idx].Size();
+    }
 
-        return false;
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Drop() noexcept
+    {
+        DestroySlots();
+        Deallocate();
     }
 
     HASHMAP_TEMPLATE_DECL()
-    U& HashMap<T, U>::At(const T& key)
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::CopyFrom(const HashMap<T, U, Hasher, KeyEqual, Alloc>& other)
     {
-        const auto hash     = std::hash<T>{}(key);
-        const auto hash_idx = hash % m_Size;
+        if (other.m_Size == 0)
+            return;
 
-        if (hash_idx >= m_Size)
-            throw std::invalid_argument("That's right, it's an invalid argument.");
-        else
+        // Same capacity and same hash function means every pair lands in the very same slot, so the control
+        // bytes can be copied over as is and no key has to be hashed again.
+        Allocate(other.m_Capacity);
+        usize i = 0;
+        try
         {
-            if (m_Table.Empty())
-                throw std::invalid_argument("It's empty my guy.");
+            for (; i < m_Capacity; ++i)
+                if (ControlGroup::IsFull(other.m_Control[i]))
+                    SlotAllocTraits::construct(m_Allocator, m_Slots + i, other.m_Slots[i]);
+        }
+        catch (...)
+        {
+            for (usize j = 0; j < i; ++j)
+                if (ControlGroup::IsFull(other.m_Control[j]))
+                    SlotAllocTraits::destroy(m_Allocator, m_Slots + j);
+            Deallocate();
+            throw;
+        }
+        std::memcpy(m_Control, other.m_Control, m_Capacity + ControlGroup::Width - 1);
+        m_Size           = other.m_Size;
+        m_GrowthLeft     = other.m_GrowthLeft;
+        m_MaxProbeLength = other.m_MaxProbeLength;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::StealFrom(HashMap<T, U, Hasher, KeyEqual, Alloc>& other) noexcept
+    {
+        m_Control        = std::exchange(other.m_Control, nullptr);
+        m_Slots          = std::exchange(other.m_Slots, nullptr);
+        m_Capacity       = std::exchange(other.m_Capacity, 0);
+        m_Size           = std::exchange(other.m_Size, 0);
+        m_GrowthLeft     = std::exchange(other.m_GrowthLeft, 0);
+        m_MaxProbeLength = std::exchange(other.m_MaxProbeLength, 0);
+    }
 
-            for (auto& e : m_Table[hash_idx])
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::SetControl(const usize index, const i8 control) noexcept
+    {
+        // Also updates the clone past the end for indices below Width - 1, for the rest it writes index twice.
+        m_Control[index] = control;
+        m_Control[((index - (ControlGroup::Width - 1)) & (m_Capacity - 1)) + (ControlGroup::Width - 1)] = control;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::FindIndex(const K& key, const usize hash) const noexcept
+    {
+        if (m_Size == 0)
+            return m_Capacity;
+        return Probe(m_Control, m_Slots, m_Capacity, m_KeyEqual, key, hash);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::Probe(const i8* control, const Slot* slots, const usize capacity,
+                                                        const KeyEqual& keyEqual, const K& key,
+                                                        const usize hash) noexcept
+    {
+        // Groups are probed in triangular steps which, with a power of two capacity, visits every group once.
+        const usize mask = capacity - 1;
+        usize       pos  = H1(hash) & mask;
+        for (usize step = ControlGroup::Width;; step += ControlGroup::Width)
+        {
+            const ControlGroup group(control + pos);
+            for (u32 match = group.Match(H2(hash)); match; match &= match - 1)
             {
-                if (e.first == key)
-                    return e.second;
+                const usize index = (pos + std::countr_zero(match)) & mask;
+                if (slots[index].hash == hash && keyEqual(slots[index].pair.first, key))
+                    return index;
             }
+            if (group.MatchEmpty())
+                return capacity;
+            pos = (pos + step) & mask;
+        }
+    }
 
-            throw std::invalid_argument("It does not exist.");
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Prefetch(const void* address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#elif defined(MY_CONTROL_GROUP_SSE2)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::FindFirstNonFull(const usize hash) noexcept
+    {
+        // Only ever called right before an insertion, so this is also where the probe length is recorded.
+        const usize mask   = m_Capacity - 1;
+        usize       pos    = H1(hash) & mask;
+        usize       probes = 1;
+        for (usize step = ControlGroup::Width;; step += ControlGroup::Width, ++probes)
+        {
+            if (const u32 match = ControlGroup(m_Control + pos).MatchEmptyOrDeleted())
+            {
+                m_MaxProbeLength = std::max(m_MaxProbeLength, probes);
+                return (pos + std::countr_zero(match)) & mask;
+            }
+            pos = (pos + step) & mask;
         }
     }
 
     HASHMAP_TEMPLATE_DECL()
-    bool HashMap<T, U>::Erase(const T& key)
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::PrepareInsert(const usize hash)
     {
-        const auto hash = std::hash<T>{}(key);
-        const auto hash_idx = hash % m_Size;
+        usize index = m_Capacity ? FindFirstNonFull(hash) : 0;
+
+        // Reusing a tombstone does not take up any of the room that is left.
+        if (!m_Capacity || (m_GrowthLeft == 0 && m_Control[index] != ControlGroup::Deleted))
+        {
+            Grow();
+            index = FindFirstNonFull(hash);
+        }
+        if (m_Control[index] == ControlGroup::Empty)
+            --m_GrowthLeft;
+        return index;
+    }
 
-        if (hash_idx >= m_Size)
-            throw std::invalid_argument("That's right, it's an invalid argument.");
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Grow()
+    {
+        // If most of what fills up the table are tombstones a rehash at the same capacity is enough to get rid
+        // of them, otherwise double it.
+        if (m_Capacity == 0)
+            Resize(InitialBucketSize);
+        else if (m_Size <= CapacityToGrowth(m_Capacity) / 2)
+            Resize(m_Capacity);
         else
+            Resize(m_Capacity * 2);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Resize(const usize newCapacity)
+    {
+        i8*         old_control          = m_Control;
+        Slot*       old_slots            = m_Slots;
+        const usize old_capacity         = m_Capacity;
+        const usize old_growth_left      = m_GrowthLeft;
+        const usize old_max_probe_length = m_MaxProbeLength;
+        const usize size                 = m_Size;
+
+        m_Control = nullptr;
+        m_Slots   = nullptr;
+        try
+        {
+            Allocate(newCapacity);
+        }
+        catch (...)
         {
-            if (m_Table.Empty())
-                throw std::invalid_argument("It's empty my guy.");
+            m_Control = old_control;
+            m_Slots   = old_slots;
+            throw;
+        }
 
-            for (auto it = m_Table[hash_idx].begin(); it != m_Table[hash_idx].end(); ++it)
+        // The old slots are only destroyed once all of them made it into the new table. If a copy throws
+        // halfway (move_if_noexcept copies when the move may throw), the old table is still whole and is put
+        // back.
+        try
+        {
+            for (usize i = 0; i < old_capacity; ++i)
             {
-                if ((*it).first == key)
-                {
-                    m_Table[hash_idx].Erase(it);
-                    return true;
-                }
+                if (!ControlGroup::IsFull(old_control[i]))
+                    continue;
+
+                const usize hash  = old_slots[i].hash;
+                const usize index = FindFirstNonFull(hash);
+                SlotAllocTraits::construct(m_Allocator, m_Slots + index, std::move_if_noexcept(old_slots[i]));
+                SetControl(index, H2(hash));
             }
         }
+        catch (...)
+        {
+            DestroySlots();
+            Deallocate();
+            m_Control        = old_control;
+            m_Slots          = old_slots;
+            m_Capacity       = old_capacity;
+            m_Size           = size;
+            m_GrowthLeft     = old_growth_left;
+            m_MaxProbeLength = old_max_probe_length;
+            throw;
+        }
+        m_Size        = size;
+        m_GrowthLeft -= size;
 
-        return false;
+        if (old_control)
+        {
+            if constexpr (!std::is_trivially_destructible_v<Slot>)
+            {
+                for (usize i = 0; i < old_capacity; ++i)
+                    if (ControlGroup::IsFull(old_control[i]))
+                        SlotAllocTraits::destroy(m_Allocator, old_slots + i);
+            }
+            CtrlAllocator ctrl_allocator(m_Allocator);
+            CtrlAllocTraits::deallocate(ctrl_allocator, old_control, old_capacity + ControlGroup::Width - 1);
+            SlotAllocTraits::deallocate(m_Allocator, old_slots, old_capacity);
+        }
     }
 
     HASHMAP_TEMPLATE_DECL()
-    bool HashMap<T, U>::ContainsKey(const T& key) const noexcept
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::EraseAt(const usize index) noexcept
     {
-        const auto hash = std::hash<T>{}(key);
-        const auto hash_idx = hash % m_Size;
-        for (const auto& e : m_Table[hash_idx])
-        {
-            if (e.first == key)
-                return true;
-        }
-        return false;
+        SlotAllocTraits::destroy(m_Allocator, m_Slots + index);
+        --m_Size;
+
+        // If there is an empty slot within Width slots on both sides of index then no probe sequence ever got
+        // past a full group here, so the slot can go back to being empty instead of becoming a tombstone.
+        const usize before       = (index - ControlGroup::Width) & (m_Capacity - 1);
+        const u32   empty_after  = ControlGroup(m_Control + index).MatchEmpty();
+        const u32   empty_before = ControlGroup(m_Control + before).MatchEmpty();
+        const bool  was_never_full =
+            empty_before && empty_after &&
+            usize(std::countr_zero(empty_after) + std::countl_zero(static_cast<u16>(empty_before))) <
+                ControlGroup::Width;
+
+        SetControl(index, was_never_full ? ControlGroup::Empty : ControlGroup::Deleted);
+        if (was_never_full)
+            ++m_GrowthLeft;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K, typename... TArgs>
+    std::pair<U*, bool> HashMap<T, U, Hasher, KeyEqual, Alloc>::TryEmplaceWithHash(const usize hash, K&& key,
+                                                                                  TArgs&&... args)
+    {
+        const usize found = FindIndex(key, hash);
+        if (found != m_Capacity)
+            return { &m_Slots[found].pair.second, false };
+
+        // Neither key nor args have been touched yet, both are forwarded straight into the slot.
+        const usize index = PrepareInsert(hash);
+        SlotAllocTraits::construct(m_Allocator, m_Slots + index, hash, std::piecewise_construct,
+                                   std::forward_as_tuple(std::forward<K>(key)),
+                                   std::forward_as_tuple(std::forward<TArgs>(args)...));
+        SetControl(index, H2(hash));
+        ++m_Size;
+        return { &m_Slots[index].pair.second, true };
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    bool HashMap<T, U, Hasher, KeyEqual, Alloc>::Insert(const T& key, const U& value)
+    {
+        return InsertWithHash(HashOf(key), key, value);
     }
 
     HASHMAP_TEMPLATE_DECL()
-    bool HashMap<T, U>::ContainsValue(const U& value) const noexcept
+    bool HashMap<T, U, Hasher, KeyEqual, Alloc>::Insert(T&& key, U&& value)
     {
-        for (const auto& l : m_Table)
+        return !InsertOrAssign(std::move(key), std::move(value)).second;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename... TArgs>
+    std::pair<U*, bool> HashMap<T, U, Hasher, KeyEqual, Alloc>::Emplace(TArgs&&... args)
+    {
+        Pair<T, U> pair(std::forward<TArgs>(args)...);
+        return TryEmplaceWithHash(HashOf(pair.first), std::move(pair.first), std::move(pair.second));
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename... TArgs>
+    std::pair<U*, bool> HashMap<T, U, Hasher, KeyEqual, Alloc>::TryEmplace(const T& key, TArgs&&... args)
+    {
+        return TryEmplaceWithHash(HashOf(key), key, std::forward<TArgs>(args)...);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename... TArgs>
+    std::pair<U*, bool> HashMap<T, U, Hasher, KeyEqual, Alloc>::TryEmplace(T&& key, TArgs&&... args)
+    {
+        const usize hash = HashOf(key);
+        return TryEmplaceWithHash(hash, std::move(key), std::forward<TArgs>(args)...);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename V>
+    std::pair<U*, bool> HashMap<T, U, Hasher, KeyEqual, Alloc>::InsertOrAssign(const T& key, V&& value)
+    {
+        // value is only forwarded into the slot when the key is new, otherwise it is still intact here.
+        auto result = TryEmplaceWithHash(HashOf(key), key, std::forward<V>(value));
+        if (!result.second)
+            *result.first = std::forward<V>(value);
+        return result;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename V>
+    std::pair<U*, bool> HashMap<T, U, Hasher, KeyEqual, Alloc>::InsertOrAssign(T&& key, V&& value)
+    {
+        const usize hash   = HashOf(key);
+        auto        result = TryEmplaceWithHash(hash, std::move(key), std::forward<V>(value));
+        if (!result.second)
+            *result.first = std::forward<V>(value);
+        return result;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    bool HashMap<T, U, Hasher, KeyEqual, Alloc>::InsertWithHash(const usize hash, const T& key, const U& value)
+    {
+        auto [existing, inserted] = TryEmplaceWithHash(hash, key, value);
+        if (!inserted)
+            *existing = value;
+        return !inserted;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    U* HashMap<T, U, Hasher, KeyEqual, Alloc>::Find(const KeyArg<K>& key) noexcept
+    {
+        return FindWithHash<K>(HashOf<K>(key), key);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    const U* HashMap<T, U, Hasher, KeyEqual, Alloc>::Find(const KeyArg<K>& key) const noexcept
+    {
+        return FindWithHash<K>(HashOf<K>(key), key);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    U* HashMap<T, U, Hasher, KeyEqual, Alloc>::FindWithHash(const usize hash, const KeyArg<K>& key) noexcept
+    {
+        const usize index = FindIndex(key, hash);
+        return index == m_Capacity ? nullptr : &m_Slots[index].pair.second;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    const U* HashMap<T, U, Hasher, KeyEqual, Alloc>::FindWithHash(const usize hash, const KeyArg<K>& key) const noexcept
+    {
+        const usize index = FindIndex(key, hash);
+        return index == m_Capacity ? nullptr : &m_Slots[index].pair.second;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::FindBatch(std::span<const KeyArg<K>> keys, std::span<U*> values)
+    {
+        const HashMap<T, U, Hasher, KeyEqual, Alloc>& self = *this;
+        return self.template FindBatch<K>(
+            keys, std::span<const U*>(const_cast<const U**>(values.data()), values.size()));
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    usize HashMap<T, U, Hasher, KeyEqual, Alloc>::FindBatch(std::span<const KeyArg<K>> keys,
+                                                            std::span<const U*>        values) const
+    {
+        if (values.size() < keys.size())
+            throw std::invalid_argument("There are fewer values than keys.");
+
+        if (m_Size == 0)
         {
-            for (const auto& e : l)
+            std::fill_n(values.begin(), keys.size(), nullptr);
+            return 0;
+        }
+
+        const usize mask  = m_Capacity - 1;
+        usize       found = 0;
+        usize       hashes[BatchSize];
+        for (usize first = 0; first < keys.size(); first += BatchSize)
+        {
+            const usize count = std::min(BatchSize, keys.size() - first);
+            for (usize i = 0; i < count; ++i)
+            {
+                hashes[i]       = HashOf<K>(keys[first + i]);
+                const usize pos = H1(hashes[i]) & mask;
+                Prefetch(m_Control + pos);
+                Prefetch(m_Slots + pos);
+            }
+            for (usize i = 0; i < count; ++i)
             {
-                if (e.second == value)
-                    return true;
+                const usize index = FindIndex(keys[first + i], hashes[i]);
+                if (index == m_Capacity)
+                    values[first + i] = nullptr;
+                else
+                {
+                    values[first + i] = &m_Slots[index].pair.second;
+                    ++found;
+                }
             }
         }
-        return false;
+        return found;
     }
 
     HASHMAP_TEMPLATE_DECL()
-    usize HashMap<T, U>::Size() const noexcept
+    template <typename K>
+    U& HashMap<T, U, Hasher, KeyEqual, Alloc>::At(const KeyArg<K>& key)
     {
-        usize sum = 0;
-        for (const auto& l : m_Table)
-            sum += l.Size();
-        return sum;
+        const usize index = FindIndex(key, HashOf<K>(key));
+        if (index == m_Capacity)
+            throw std::invalid_argument("It does not exist.");
+        return m_Slots[index].pair.second;
     }
 
     HASHMAP_TEMPLATE_DECL()
-    bool HashMap<T, U>::Empty() const noexcept
+    template <typename K>
+    bool HashMap<T, U, Hasher, KeyEqual, Alloc>::Erase(const KeyArg<K>& key)
     {
-        for (const auto& l : m_Table)
-            for (const auto& e : l)
-                return false;
+        const usize index = FindIndex(key, HashOf<K>(key));
+        if (index == m_Capacity)
+            return false;
+
+        EraseAt(index);
         return true;
     }
 
     HASHMAP_TEMPLATE_DECL()
-    void HashMap<T, U>::Clear() noexcept
+    template <typename K>
+    bool HashMap<T, U, Hasher, KeyEqual, Alloc>::ContainsKey(const KeyArg<K>& key) const noexcept
+    {
+        return FindIndex(key, HashOf<K>(key)) != m_Capacity;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    bool HashMap<T, U, Hasher, KeyEqual, Alloc>::ContainsValue(const U& value) const noexcept
+    {
+        for (const U& other : ValuesView())
+            if (other == value)
+                return true;
+        return false;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Clear() noexcept
     {
-        for (const auto& l : m_Table)
-            l.Clear();
+        // Keeps the storage around, only the pairs and the tombstones go away.
+        DestroySlots();
+        if (m_Control)
+            std::memset(m_Control, static_cast<u8>(ControlGroup::Empty), m_Capacity + ControlGroup::Width - 1);
+        m_Size           = 0;
+        m_GrowthLeft     = CapacityToGrowth(m_Capacity);
+        m_MaxProbeLength = 0;
     }
 
     HASHMAP_TEMPLATE_DECL()
-    my::Vec<U> HashMap<T, U>::Values() const noexcept
+    my::Vec<U> HashMap<T, U, Hasher, KeyEqual, Alloc>::Values() const noexcept
     {
         my::Vec<U> values{};
-        for (const auto& l : m_Table)
-            for (const auto& e : l)
-                values.Push(e.second);
+        values.Reserve(m_Size);
+        for (const U& value : ValuesView())
+            values.Push(value);
         return values;
     }
 
     HASHMAP_TEMPLATE_DECL()
-    std::unordered_set<T> HashMap<T, U>::KeySet() const noexcept
+    std::unordered_set<T> HashMap<T, U, Hasher, KeyEqual, Alloc>::KeySet() const noexcept
     {
         std::unordered_set<T> set{};
-        for (const auto& l : m_Table)
-            for (const auto& e : l)
-                set.insert(e.first);
+        set.reserve(m_Size);
+        for (const T& key : KeysView())
+            set.insert(key);
         return set;
     }
 
     HASHMAP_TEMPLATE_DECL()
-    std::unordered_set<U> HashMap<T, U>::ValueSet() const noexcept
+    std::unordered_set<U> HashMap<T, U, Hasher, KeyEqual, Alloc>::ValueSet() const noexcept
     {
         std::unordered_set<U> set{};
-        for (const auto& l : m_Table)
-            for (const auto& e : l)
-                set.insert(e.second);
+        for (const U& value : ValuesView())
+            set.insert(value);
         return set;
     }
+
+    HASHMAP_TEMPLATE_DECL()
+    typename HashMap<T, U, Hasher, KeyEqual, Alloc>::template View<
+        typename HashMap<T, U, Hasher, KeyEqual, Alloc>::KeyIterator>
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::KeysView() const noexcept
+    {
+        return { KeyIterator(m_Control, m_Slots, 0, m_Capacity),
+                 KeyIterator(m_Control, m_Slots, m_Capacity, m_Capacity), m_Size };
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    typename HashMap<T, U, Hasher, KeyEqual, Alloc>::template View<
+        typename HashMap<T, U, Hasher, KeyEqual, Alloc>::ValueIterator>
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::ValuesView() noexcept
+    {
+        return { ValueIterator(m_Control, m_Slots, 0, m_Capacity),
+                 ValueIterator(m_Control, m_Slots, m_Capacity, m_Capacity), m_Size };
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    typename HashMap<T, U, Hasher, KeyEqual, Alloc>::template View<
+        typename HashMap<T, U, Hasher, KeyEqual, Alloc>::ConstValueIterator>
+    HashMap<T, U, Hasher, KeyEqual, Alloc>::ValuesView() const noexcept
+    {
+        return { ConstValueIterator(m_Control, m_Slots, 0, m_Capacity),
+                 ConstValueIterator(m_Control, m_Slots, m_Capacity, m_Capacity), m_Size };
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Save(const std::string& path) const
+        requires std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<U>
+    {
+        const usize control_size = m_Capacity ? m_Capacity + ControlGroup::Width - 1 : 0;
+        const usize slots_offset =
+            (sizeof(SnapshotHeader) + control_size + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+        SnapshotHeader header{};
+        header.Magic       = SnapshotHeader::ExpectedMagic;
+        header.Version     = SnapshotHeader::ExpectedVersion;
+        header.GroupWidth  = static_cast<u32>(ControlGroup::Width);
+        header.KeySize     = static_cast<u32>(sizeof(T));
+        header.ValueSize   = static_cast<u32>(sizeof(U));
+        header.SlotSize    = static_cast<u32>(sizeof(Slot));
+        header.SlotAlign   = static_cast<u32>(alignof(Slot));
+        header.Capacity    = m_Capacity;
+        header.Size        = m_Size;
+        header.SlotsOffset = slots_offset;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.exceptions(std::ios::failbit | std::ios::badbit);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(m_Control), std::streamsize(control_size));
+
+        const char zeros[alignof(Slot) > sizeof(Slot) ? alignof(Slot) : sizeof(Slot)]{};
+        file.write(zeros, std::streamsize(slots_offset - sizeof(SnapshotHeader) - control_size));
+        // Empty slots hold no object, they are written as zeros. Runs of full slots go out in one write.
+        for (usize i = 0; i < m_Capacity;)
+        {
+            if (!ControlGroup::IsFull(m_Control[i]))
+            {
+                file.write(zeros, sizeof(Slot));
+                ++i;
+                continue;
+            }
+            usize last = i + 1;
+            while (last < m_Capacity && ControlGroup::IsFull(m_Control[last]))
+                ++last;
+            file.write(reinterpret_cast<const char*>(m_Slots + i), std::streamsize((last - i) * sizeof(Slot)));
+            i = last;
+        }
+        file.close();
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Swap(HashMap<T, U, Hasher, KeyEqual, Alloc>& other) noexcept
+    {
+        if constexpr (SlotAllocTraits::propagate_on_container_swap::value)
+            std::swap(m_Allocator, other.m_Allocator);
+        std::swap(m_Control, other.m_Control);
+        std::swap(m_Slots, other.m_Slots);
+        std::swap(m_Capacity, other.m_Capacity);
+        std::swap(m_Size, other.m_Size);
+        std::swap(m_GrowthLeft, other.m_GrowthLeft);
+        std::swap(m_MaxProbeLength, other.m_MaxProbeLength);
+        std::swap(m_MaxLoadFactor, other.m_MaxLoadFactor);
+        std::swap(m_Hash, other.m_Hash);
+        std::swap(m_KeyEqual, other.m_KeyEqual);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Reserve(const usize count)
+    {
+        // Makes room for count elements in one go, so a bulk load does not rehash over and over again.
+        const usize capacity = CapacityFor(count);
+        if (capacity > m_Capacity)
+            Resize(capacity);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::Rehash(const usize bucketCount)
+    {
+        // Rebuilds the table with at least bucketCount slots (rounded up to a power of two) but never less
+        // than what the current elements need, which also clears out every tombstone. Rehash(0) on an empty
+        // map frees its storage.
+        if (bucketCount == 0 && m_Size == 0)
+        {
+            Drop();
+            return;
+        }
+
+        const usize capacity = std::max(std::bit_ceil(std::max(bucketCount, InitialBucketSize)), CapacityFor(m_Size));
+        Resize(capacity);
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    void HashMap<T, U, Hasher, KeyEqual, Alloc>::MaxLoadFactor(const f32 loadFactor)
+    {
+        m_MaxLoadFactor = std::clamp(loadFactor, MinMaxLoadFactor, MaxMaxLoadFactor);
+        if (!m_Capacity)
+            return;
+
+        // The room that is left depends on the load factor (and on the tombstones, which are not counted), so
+        // rebuild the table, growing it if the elements do not fit anymore.
+        Resize(std::max(m_Capacity, CapacityFor(m_Size)));
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    HashMap<T, U, Hasher, KeyEqual, Alloc>& HashMap<T, U, Hasher, KeyEqual, Alloc>::operator=(
+        const HashMap<T, U, Hasher, KeyEqual, Alloc>& other)
+    {
+        if (&other == this)
+            return *this;
+
+        Drop();
+        if constexpr (SlotAllocTraits::propagate_on_container_copy_assignment::value)
+            m_Allocator = other.m_Allocator;
+        m_Hash          = other.m_Hash;
+        m_KeyEqual      = other.m_KeyEqual;
+        m_MaxLoadFactor = other.m_MaxLoadFactor;
+        CopyFrom(other);
+        return *this;
+    }
+
+    HASHMAP_TEMPLATE_DECL()
+    HashMap<T, U, Hasher, KeyEqual, Alloc>& HashMap<T, U, Hasher, KeyEqual, Alloc>::operator=(
+        HashMap<T, U, Hasher, KeyEqual, Alloc>&& other) noexcept(
+            SlotAllocTraits::propagate_on_container_move_assignment::value || SlotAllocTraits::is_always_equal::value)
+    {
+        if (&other == this)
+            return *this;
+
+        Drop();
+        m_Hash          = std::move(other.m_Hash);
+        m_KeyEqual      = std::move(other.m_KeyEqual);
+        m_MaxLoadFactor = other.m_MaxLoadFactor;
+        if constexpr (!SlotAllocTraits::propagate_on_container_move_assignment::value &&
+                      !SlotAllocTraits::is_always_equal::value)
+        {
+            // The table belongs to a different memory resource, so the pairs have to be moved one by one.
+            if (m_Allocator != other.m_Allocator)
+            {
+                if (other.m_Size)
+                {
+                    Allocate(other.m_Capacity);
+                    usize i = 0;
+                    try
+                    {
+                        for (; i < m_Capacity; ++i)
+                            if (ControlGroup::IsFull(other.m_Control[i]))
+                                SlotAllocTraits::construct(m_Allocator, m_Slots + i, std::move(other.m_Slots[i]));
+                    }
+                    catch (...)
+                    {
+                        for (usize j = 0; j < i; ++j)
+                            if (ControlGroup::IsFull(other.m_Control[j]))
+                                SlotAllocTraits::destroy(m_Allocator, m_Slots + j);
+                        Deallocate();
+                        throw;
+                    }
+                    std::memcpy(m_Control, other.m_Control, m_Capacity + ControlGroup::Width - 1);
+                    m_Size           = other.m_Size;
+                    m_GrowthLeft     = other.m_GrowthLeft;
+                    m_MaxProbeLength = other.m_MaxProbeLength;
+                }
+                other.Drop();
+                return *this;
+            }
+        }
+
+        if constexpr (SlotAllocTraits::propagate_on_container_move_assignment::value)
+            m_Allocator = std::move(other.m_Allocator);
+        StealFrom(other);
+        return *this;
+    }
 } // namespace my
 
 #undef HASHMAP_TEMPLATE_DECL
@@ -0,0 +1,86 @@
+#ifndef MY_MAPPED_HASH_MAP_H
+#define MY_MAPPED_HASH_MAP_H
+
+#include <string>
+#include <type_traits>
+
+#include <CommonDef.h>
+
+#include "HashMap.h"
+#include "Utilities/MappedFile.h"
+
+namespace my {
+    // A read-only HashMap backed by a file written with HashMap::Save(). The file is mapped into memory and
+    // its table is probed where it lies, so opening it costs no more than the mapping itself and pages are
+    // only read from disk once a lookup touches them.
+    template <typename T, typename U, typename Hasher = Hash<T>, typename KeyEqual = std::equal_to<>>
+    class MappedHashMap
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<U>,
+                      "Only trivially copyable keys and values can be used from a mapped file.");
+
+    public:
+        using Map                = HashMap<T, U, Hasher, KeyEqual>;
+        using ConstIterator      = typename Map::ConstIterator;
+        using KeyIterator        = typename Map::KeyIterator;
+        using ConstValueIterator = typename Map::ConstValueIterator;
+        template <typename It>
+        using View = typename Map::template View<It>;
+
+    private:
+        using Slot = typename Map::Slot;
+
+        template <typename K>
+        using KeyArg = typename Map::template KeyArg<K>;
+
+    private:
+        MappedFile                     m_File{};
+        [[no_unique_address]] Hasher   m_Hash{};
+        [[no_unique_address]] KeyEqual m_KeyEqual{};
+        const i8*                      m_Control  = nullptr;
+        const Slot*                    m_Slots    = nullptr;
+        usize                          m_Capacity = 0;
+        usize                          m_Size     = 0;
+
+    public:
+        // Throws std::system_error if the file can not be mapped and std::invalid_argument if it is not a
+        // snapshot of this kind of map.
+        explicit MappedHashMap(const std::string& path, const Hasher& hash = Hasher(),
+                               const KeyEqual& keyEqual = KeyEqual());
+        MappedHashMap(const MappedHashMap<T, U, Hasher, KeyEqual>&) = delete;
+        MappedHashMap(MappedHashMap<T, U, Hasher, KeyEqual>&& other) noexcept;
+
+    private:
+        // Whether every control byte is a valid state, size of them are full, at least one is empty so every
+        // probe terminates and the clone of the first group past the end matches it.
+        static bool IsValidControl(const i8* control, const usize capacity, const usize size) noexcept;
+
+    public:
+        template <typename K = T>
+        const U*                 Find(const KeyArg<K>& key) const noexcept;
+        template <typename K = T>
+        const U&                 At(const KeyArg<K>& key) const;
+        template <typename K = T>
+        bool                     ContainsKey(const KeyArg<K>& key) const noexcept;
+        ConstIterator            begin() const noexcept { return ConstIterator(m_Control, m_Slots, 0, m_Capacity); }
+        ConstIterator            end() const noexcept
+        {
+            return ConstIterator(m_Control, m_Slots, m_Capacity, m_Capacity);
+        }
+        View<KeyIterator>        KeysView() const noexcept;
+        View<ConstValueIterator> ValuesView() const noexcept;
+
+    public:
+        constexpr usize Size() const noexcept { return m_Size; }
+        constexpr bool  Empty() const noexcept { return m_Size == 0; }
+        constexpr usize BucketCount() const noexcept { return m_Capacity; }
+
+    public:
+        MappedHashMap<T, U, Hasher, KeyEqual>& operator=(const MappedHashMap<T, U, Hasher, KeyEqual>&) = delete;
+        MappedHashMap<T, U, Hasher, KeyEqual>& operator=(MappedHashMap<T, U, Hasher, KeyEqual>&& other) noexcept;
+    };
+} // namespace my
+
+#include "MappedHashMap.hpp"
+
+#endif // MY_MAPPED_HASH_MAP_H
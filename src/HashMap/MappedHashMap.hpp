@@ -0,0 +1,146 @@
+#ifndef MY_MAPPED_HASH_MAP_IMPL_HPP
+#define MY_MAPPED_HASH_MAP_IMPL_HPP
+
+#include <bit>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#define MAPPED_HASHMAP_TEMPLATE_DECL() template <typename T, typename U, typename Hasher, typename KeyEqual>
+
+namespace my {
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    MappedHashMap<T, U, Hasher, KeyEqual>::MappedHashMap(const std::string& path, const Hasher& hash,
+                                                         const KeyEqual& keyEqual)
+        : m_File(path), m_Hash(hash), m_KeyEqual(keyEqual)
+    {
+        SnapshotHeader header;
+        if (m_File.Size() < sizeof(header))
+            throw std::invalid_argument("It is not a HashMap snapshot.");
+        std::memcpy(&header, m_File.Data(), sizeof(header));
+
+        if (header.Magic != SnapshotHeader::ExpectedMagic || header.Version != SnapshotHeader::ExpectedVersion)
+            throw std::invalid_argument("It is not a HashMap snapshot.");
+        if (header.GroupWidth != ControlGroup::Width || header.KeySize != sizeof(T) ||
+            header.ValueSize != sizeof(U) || header.SlotSize != sizeof(Slot) || header.SlotAlign != alignof(Slot))
+            throw std::invalid_argument("The snapshot was written for a different key, value or table layout.");
+
+        // The file has to hold the whole table, otherwise a probe could run off the end of the mapping.
+        const usize control_size = header.Capacity ? header.Capacity + ControlGroup::Width - 1 : 0;
+        const bool  valid_capacity =
+            header.Capacity ? std::has_single_bit(header.Capacity) && header.Capacity >= ControlGroup::Width &&
+                                  header.Size < header.Capacity
+                            : header.Size == 0;
+        const bool  valid_offset =
+            header.SlotsOffset % alignof(Slot) == 0 && header.SlotsOffset >= sizeof(header) + control_size &&
+            header.SlotsOffset <= m_File.Size();
+        if (!valid_capacity || !valid_offset || header.Capacity > (m_File.Size() - header.SlotsOffset) / sizeof(Slot))
+            throw std::invalid_argument("The snapshot is truncated or corrupted.");
+
+        if (header.Capacity)
+        {
+            // Probes trust the control bytes, a table without an empty one would never let a miss return.
+            const i8* control = reinterpret_cast<const i8*>(m_File.Data() + sizeof(header));
+            if (!IsValidControl(control, header.Capacity, header.Size))
+                throw std::invalid_argument("The snapshot is truncated or corrupted.");
+            m_Control = control;
+            m_Slots   = std::launder(reinterpret_cast<const Slot*>(m_File.Data() + header.SlotsOffset));
+        }
+        m_Capacity = header.Capacity;
+        m_Size     = header.Size;
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    bool MappedHashMap<T, U, Hasher, KeyEqual>::IsValidControl(const i8* control, const usize capacity,
+                                                               const usize size) noexcept
+    {
+        usize full = 0, empty = 0;
+        for (usize i = 0; i < capacity; ++i)
+        {
+            if (ControlGroup::IsFull(control[i]))
+                ++full;
+            else if (control[i] == ControlGroup::Empty)
+                ++empty;
+            else if (control[i] != ControlGroup::Deleted)
+                return false;
+        }
+        return full == size && empty != 0 &&
+               std::memcmp(control + capacity, control, ControlGroup::Width - 1) == 0;
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    MappedHashMap<T, U, Hasher, KeyEqual>::MappedHashMap(MappedHashMap<T, U, Hasher, KeyEqual>&& other) noexcept
+        : m_File(std::move(other.m_File)), m_Hash(std::move(other.m_Hash)), m_KeyEqual(std::move(other.m_KeyEqual)),
+          m_Control(std::exchange(other.m_Control, nullptr)), m_Slots(std::exchange(other.m_Slots, nullptr)),
+          m_Capacity(std::exchange(other.m_Capacity, 0)), m_Size(std::exchange(other.m_Size, 0))
+    {
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    const U* MappedHashMap<T, U, Hasher, KeyEqual>::Find(const KeyArg<K>& key) const noexcept
+    {
+        if (m_Size == 0)
+            return nullptr;
+
+        const usize index = Map::Probe(m_Control, m_Slots, m_Capacity, m_KeyEqual, key, Map::Mix(m_Hash(key)));
+        return index == m_Capacity ? nullptr : &m_Slots[index].pair.second;
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    const U& MappedHashMap<T, U, Hasher, KeyEqual>::At(const KeyArg<K>& key) const
+    {
+        const U* value = Find<K>(key);
+        if (!value)
+            throw std::invalid_argument("It does not exist.");
+        return *value;
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    template <typename K>
+    bool MappedHashMap<T, U, Hasher, KeyEqual>::ContainsKey(const KeyArg<K>& key) const noexcept
+    {
+        return Find<K>(key) != nullptr;
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    typename MappedHashMap<T, U, Hasher, KeyEqual>::template View<
+        typename MappedHashMap<T, U, Hasher, KeyEqual>::KeyIterator>
+    MappedHashMap<T, U, Hasher, KeyEqual>::KeysView() const noexcept
+    {
+        return { KeyIterator(m_Control, m_Slots, 0, m_Capacity),
+                 KeyIterator(m_Control, m_Slots, m_Capacity, m_Capacity), m_Size };
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    typename MappedHashMap<T, U, Hasher, KeyEqual>::template View<
+        typename MappedHashMap<T, U, Hasher, KeyEqual>::ConstValueIterator>
+    MappedHashMap<T, U, Hasher, KeyEqual>::ValuesView() const noexcept
+    {
+        return { ConstValueIterator(m_Control, m_Slots, 0, m_Capacity),
+                 ConstValueIterator(m_Control, m_Slots, m_Capacity, m_Capacity), m_Size };
+    }
+
+    MAPPED_HASHMAP_TEMPLATE_DECL()
+    MappedHashMap<T, U, Hasher, KeyEqual>& MappedHashMap<T, U, Hasher, KeyEqual>::operator=(
+        MappedHashMap<T, U, Hasher, KeyEqual>&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        m_File     = std::move(other.m_File);
+        m_Hash     = std::move(other.m_Hash);
+        m_KeyEqual = std::move(other.m_KeyEqual);
+        m_Control  = std::exchange(other.m_Control, nullptr);
+        m_Slots    = std::exchange(other.m_Slots, nullptr);
+        m_Capacity = std::exchange(other.m_Capacity, 0);
+        m_Size     = std::exchange(other.m_Size, 0);
+        return *this;
+    }
+} // namespace my
+
+#undef MAPPED_HASHMAP_TEMPLATE_DECL
+
+#endif // MY_MAPPED_HASH_MAP_IMPL_HPP
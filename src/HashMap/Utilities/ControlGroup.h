@@ -0,0 +1,76 @@
+#ifndef MY_CONTROL_GROUP_H
+#define MY_CONTROL_GROUP_H
+
+#include <cstring>
+
+#include <CommonDef.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MY_CONTROL_GROUP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace my {
+    // A group of control bytes of the open addressing table in HashMap. Every slot of the table has one
+    // control byte that is either Empty, Deleted (a tombstone) or, for full slots, the lower 7 bits of the
+    // hash of the key that lives there. A lookup loads Width control bytes at once and compares all of them
+    // against the 7 bit hash in one go (a single SSE2 compare where available), so only the slots whose
+    // control byte matches ever have their keys compared.
+    class ControlGroup
+    {
+    public:
+        static constexpr usize Width   = 16;
+        static constexpr i8    Empty   = -128; // 0b10000000
+        static constexpr i8    Deleted = -2;   // 0b11111110
+
+    private:
+#ifdef MY_CONTROL_GROUP_SSE2
+        __m128i m_Control;
+#else
+        i8 m_Control[Width];
+#endif
+
+    public:
+        explicit ControlGroup(const i8* control) noexcept
+        {
+#ifdef MY_CONTROL_GROUP_SSE2
+            m_Control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+            std::memcpy(m_Control, control, Width);
+#endif
+        }
+
+    public:
+        static constexpr bool IsFull(const i8 control) noexcept { return control >= 0; }
+
+    public:
+        // Each of the following returns a bit mask where bit i is set if the i-th control byte matches.
+        u32 Match(const i8 h2) const noexcept
+        {
+#ifdef MY_CONTROL_GROUP_SSE2
+            return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_Control)));
+#else
+            u32 mask = 0;
+            for (usize i = 0; i < Width; ++i)
+                mask |= u32(m_Control[i] == h2) << i;
+            return mask;
+#endif
+        }
+        u32 MatchEmpty() const noexcept { return Match(Empty); }
+        u32 MatchEmptyOrDeleted() const noexcept
+        {
+#ifdef MY_CONTROL_GROUP_SSE2
+            // Both Empty and Deleted are smaller than -1, full slots never are.
+            return static_cast<u32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_Control)));
+#else
+            u32 mask = 0;
+            for (usize i = 0; i < Width; ++i)
+                mask |= u32(m_Control[i] < -1) << i;
+            return mask;
+#endif
+        }
+        u32 MatchFull() const noexcept { return ~MatchEmptyOrDeleted() & ((1u << Width) - 1); }
+    };
+} // namespace my
+
+#endif // MY_CONTROL_GROUP_H
@@ -0,0 +1,33 @@
+#ifndef MY_HASH_H
+#define MY_HASH_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <CommonDef.h>
+
+namespace my {
+    // The default hasher of HashMap, std::hash for everything except strings.
+    template <typename T>
+    struct Hash : std::hash<T>
+    {
+    };
+
+    // Strings are hashed through std::string_view so that std::string, std::string_view and const char* all
+    // hash the same, is_transparent then lets HashMap look them up without building a std::string first.
+    template <>
+    struct Hash<std::string>
+    {
+        using is_transparent = void;
+
+        usize operator()(const std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+    };
+
+    template <>
+    struct Hash<std::string_view> : Hash<std::string>
+    {
+    };
+} // namespace my
+
+#endif // MY_HASH_H
@@ -0,0 +1,23 @@
+#ifndef MY_KEY_ARG_H
+#define MY_KEY_ARG_H
+
+namespace my {
+    // Picks the type a lookup takes its key as, Q itself if the container's hasher and comparator are
+    // transparent and the key type otherwise. It is a member alias rather than std::conditional_t, which would
+    // hide Q behind a nested ::type, so Q is still deduced from the argument of a lookup.
+    template <bool Transparent>
+    struct KeyArgOf
+    {
+        template <typename Q, typename Key>
+        using Type = Key;
+    };
+
+    template <>
+    struct KeyArgOf<true>
+    {
+        template <typename Q, typename Key>
+        using Type = Q;
+    };
+} // namespace my
+
+#endif // MY_KEY_ARG_H
@@ -0,0 +1,137 @@
+#include "MappedFile.h"
+
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace my {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path)
+    {
+        const auto fail = [this](const char* what) {
+            const auto error = static_cast<int>(GetLastError());
+            Close();
+            throw std::system_error(error, std::system_category(), what);
+        };
+
+        m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE)
+        {
+            m_File = nullptr;
+            fail("Could not open the file.");
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_File, &size))
+            fail("Could not get the size of the file.");
+        m_Size = static_cast<usize>(size.QuadPart);
+        // Empty files can not be mapped, they simply stay without data.
+        if (m_Size == 0)
+            return;
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_Mapping)
+            fail("Could not map the file.");
+        m_Data = static_cast<const u8*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data)
+            fail("Could not map the file.");
+    }
+
+    void MappedFile::Close() noexcept
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping)
+            CloseHandle(m_Mapping);
+        if (m_File)
+            CloseHandle(m_File);
+        m_Data    = nullptr;
+        m_Size    = 0;
+        m_Mapping = nullptr;
+        m_File    = nullptr;
+    }
+#else
+    MappedFile::MappedFile(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "Could not open the file.");
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Could not get the size of the file.");
+        }
+        m_Size = static_cast<usize>(info.st_size);
+        // Empty files can not be mapped, they simply stay without data.
+        if (m_Size == 0)
+        {
+            ::close(fd);
+            return;
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        void*     data  = ::mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            m_Size = 0;
+            throw std::system_error(error, std::generic_category(), "Could not map the file.");
+        }
+        m_Data = static_cast<const u8*>(data);
+    }
+
+    void MappedFile::Close() noexcept
+    {
+        if (m_Data)
+            ::munmap(const_cast<u8*>(m_Data), m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0))
+#ifdef _WIN32
+          ,
+          m_File(std::exchange(other.m_File, nullptr)), m_Mapping(std::exchange(other.m_Mapping, nullptr))
+#endif
+    {
+    }
+
+    MappedFile::~MappedFile() noexcept
+    {
+        Close();
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        Close();
+        m_Data = std::exchange(other.m_Data, nullptr);
+        m_Size = std::exchange(other.m_Size, 0);
+#ifdef _WIN32
+        m_File    = std::exchange(other.m_File, nullptr);
+        m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+        return *this;
+    }
+} // namespace my
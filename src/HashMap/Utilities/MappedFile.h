@@ -0,0 +1,42 @@
+#ifndef MY_UTILITIES_MAPPED_FILE_H
+#define MY_UTILITIES_MAPPED_FILE_H
+
+#include <string>
+
+#include <CommonDef.h>
+
+namespace my {
+    // A whole file mapped read-only into memory, unmapped again on destruction. The mapping starts on a page
+    // boundary so anything stored at a suitably aligned offset of the file can be used in place.
+    class MappedFile
+    {
+    private:
+        const u8* m_Data = nullptr;
+        usize     m_Size = 0;
+#ifdef _WIN32
+        void* m_File    = nullptr;
+        void* m_Mapping = nullptr;
+#endif
+
+    public:
+        MappedFile() noexcept = default;
+        // Throws std::system_error if the file can not be opened or mapped.
+        explicit MappedFile(const std::string& path);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        ~MappedFile() noexcept;
+
+    private:
+        void Close() noexcept;
+
+    public:
+        constexpr const u8* Data() const noexcept { return m_Data; }
+        constexpr usize     Size() const noexcept { return m_Size; }
+
+    public:
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+    };
+} // namespace my
+
+#endif // MY_UTILITIES_MAPPED_FILE_H
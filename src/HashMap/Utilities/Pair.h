@@ -1,7 +1,10 @@
 #ifndef MY_PAIR_H
 #define MY_PAIR_H
 
+#include <concepts>
 #include <iostream>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace my {
@@ -12,12 +15,46 @@ namespace my {
         U second;
 
     public:
+        Pair() = default;
+        template <typename TFirst, typename TSecond>
+            requires std::constructible_from<T, TFirst&&> && std::constructible_from<U, TSecond&&>
+        Pair(TFirst&& first, TSecond&& second) noexcept(std::is_nothrow_constructible_v<T, TFirst&&> &&
+                                                        std::is_nothrow_constructible_v<U, TSecond&&>)
+            : first(std::forward<TFirst>(first)), second(std::forward<TSecond>(second))
+        {
+        }
+        // Converts from a Pair of other types, which is how a Pair of references is built from a stored Pair.
+        template <typename TFirst, typename TSecond>
+            requires(!std::same_as<Pair<TFirst, TSecond>, Pair>) && std::constructible_from<T, TFirst&> &&
+                    std::constructible_from<U, TSecond&>
+        Pair(Pair<TFirst, TSecond>& other) : first(other.first), second(other.second)
+        {
+        }
+        template <typename TFirst, typename TSecond>
+            requires std::constructible_from<T, const TFirst&> && std::constructible_from<U, const TSecond&>
+        Pair(const Pair<TFirst, TSecond>& other) : first(other.first), second(other.second)
+        {
+        }
+        template <typename TFirst, typename TSecond>
+            requires std::constructible_from<T, TFirst&&> && std::constructible_from<U, TSecond&&>
+        Pair(Pair<TFirst, TSecond>&& other)
+            : first(std::forward<TFirst>(other.first)), second(std::forward<TSecond>(other.second))
+        {
+        }
+        // Builds first and second in place from the elements of each tuple, like std::pair's piecewise constructor.
         template <typename... TArgs, typename... UArgs>
-        static Pair<T, U> New(TArgs&&... targs, UArgs&&... uargs) noexcept
+        Pair(std::piecewise_construct_t, std::tuple<TArgs...> targs, std::tuple<UArgs...> uargs)
+            : first(std::make_from_tuple<T>(std::move(targs))), second(std::make_from_tuple<U>(std::move(uargs)))
         {
-            return Pair{ T(std::forward<TArgs>(targs)...), U(std::forward<UArgs>(uargs)...) };
         }
-        static Pair<T, U> New(const T& first, const U& second) noexcept { return Pair{ first, second }; }
+
+    public:
+        template <typename TFirst, typename TSecond>
+        static Pair<T, U> New(TFirst&& first, TSecond&& second) noexcept(
+            std::is_nothrow_constructible_v<Pair<T, U>, TFirst&&, TSecond&&>)
+        {
+            return Pair<T, U>(std::forward<TFirst>(first), std::forward<TSecond>(second));
+        }
 
     public:
         friend std::ostream& operator<<(std::ostream& stream, const my::Pair<T, U>& pair) noexcept
@@ -28,4 +65,25 @@ namespace my {
     };
 } // namespace my
 
+// Pairs of references that iterators hand out have a common reference with the Pair they stand for, like
+// std::pair does in C++23, which is what the iterator concepts and the std::ranges algorithms ask for.
+template <typename T1, typename T2, typename U1, typename U2, template <typename> typename TQual,
+          template <typename> typename UQual>
+    requires requires {
+        typename my::Pair<std::common_reference_t<TQual<T1>, UQual<U1>>,
+                          std::common_reference_t<TQual<T2>, UQual<U2>>>;
+    }
+struct std::basic_common_reference<my::Pair<T1, T2>, my::Pair<U1, U2>, TQual, UQual>
+{
+    using type =
+        my::Pair<std::common_reference_t<TQual<T1>, UQual<U1>>, std::common_reference_t<TQual<T2>, UQual<U2>>>;
+};
+
+template <typename T1, typename T2, typename U1, typename U2>
+    requires requires { typename my::Pair<std::common_type_t<T1, U1>, std::common_type_t<T2, U2>>; }
+struct std::common_type<my::Pair<T1, T2>, my::Pair<U1, U2>>
+{
+    using type = my::Pair<std::common_type_t<T1, U1>, std::common_type_t<T2, U2>>;
+};
+
 #endif // MY_PAIR_H
@@ -0,0 +1,29 @@
+#ifndef MY_UTILITIES_SNAPSHOT_H
+#define MY_UTILITIES_SNAPSHOT_H
+
+#include <CommonDef.h>
+
+namespace my {
+    // The header at the start of a file written by HashMap::Save(). It is followed by the control bytes and
+    // then, at SlotsOffset, by the slots exactly as they are laid out in memory, which is what lets
+    // MappedHashMap use a mapping of the file as its table. Everything is stored in the native byte order and
+    // the sizes recorded here are checked on load, so a file only loads on a build with the same layout.
+    struct SnapshotHeader
+    {
+        static constexpr u64 ExpectedMagic   = 0x313050414D48594D; // "MYHMAP01" read as a little endian u64.
+        static constexpr u32 ExpectedVersion = 1;
+
+        u64 Magic;
+        u32 Version;
+        u32 GroupWidth;
+        u32 KeySize;
+        u32 ValueSize;
+        u32 SlotSize;
+        u32 SlotAlign;
+        u64 Capacity;
+        u64 Size;
+        u64 SlotsOffset;
+    };
+} // namespace my
+
+#endif // MY_UTILITIES_SNAPSHOT_H
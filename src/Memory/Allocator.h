@@ -0,0 +1,93 @@
+#ifndef MY_ALLOCATOR_H
+#define MY_ALLOCATOR_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <CommonDef.h>
+
+namespace my {
+    // The default allocator of every container in here. It is a drop-in std::allocator (so it can be swapped
+    // for std::allocator, std::pmr::polymorphic_allocator or any other allocator that follows the standard
+    // Allocator requirements) that sits on top of malloc() so that it can additionally offer Reallocate().
+    template <typename T>
+    class Allocator
+    {
+    public:
+        using value_type                             = T;
+        using size_type                              = usize;
+        using difference_type                        = ptrdiff;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal                        = std::true_type;
+
+    private:
+        static constexpr bool IsOverAligned = alignof(T) > alignof(std::max_align_t);
+
+    public:
+        constexpr Allocator() noexcept = default;
+        template <typename U>
+        constexpr Allocator(const Allocator<U>&) noexcept
+        {
+        }
+
+    public:
+        [[nodiscard]] T* allocate(const usize count)
+        {
+            if (count > std::numeric_limits<usize>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+
+            if constexpr (IsOverAligned)
+                return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ alignof(T) }));
+            else
+            {
+                auto* ptr = static_cast<T*>(std::malloc(count * sizeof(T)));
+                if (!ptr)
+                    throw std::bad_alloc();
+                return ptr;
+            }
+        }
+        void deallocate(T* ptr, const usize) noexcept
+        {
+            if constexpr (IsOverAligned)
+                ::operator delete(ptr, std::align_val_t{ alignof(T) });
+            else
+                std::free(ptr);
+        }
+        // Grows or shrinks the block at ptr with realloc(), which may extend it in place instead of copying.
+        // The bytes are carried over as is, so it is only meant for trivially relocatable types.
+        [[nodiscard]] T* Reallocate(T* ptr, const usize, const usize newCount)
+            requires(!IsOverAligned)
+        {
+            if (newCount > std::numeric_limits<usize>::max() / sizeof(T))
+                throw std::bad_array_new_length();
+
+            auto* new_ptr = static_cast<T*>(std::realloc(ptr, newCount * sizeof(T)));
+            if (!new_ptr)
+                throw std::bad_alloc();
+            return new_ptr;
+        }
+
+    public:
+        template <typename U>
+        friend constexpr bool operator==(const Allocator<T>&, const Allocator<U>&) noexcept
+        {
+            return true;
+        }
+    };
+
+    // Allocators that, like my::Allocator, can resize a block in place through Reallocate().
+    template <typename A>
+    concept IsReallocatingAllocator = requires(A& allocator, typename std::allocator_traits<A>::pointer ptr,
+                                               const usize count) {
+        {
+            allocator.Reallocate(ptr, count, count)
+        } -> std::same_as<typename std::allocator_traits<A>::pointer>;
+    };
+} // namespace my
+
+#endif // MY_ALLOCATOR_H
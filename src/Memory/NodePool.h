@@ -0,0 +1,212 @@
+#ifndef MY_NODE_POOL_H
+#define MY_NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <CommonDef.h>
+
+#include "Allocator.h"
+
+namespace my {
+    // A slab allocator for the fixed size nodes of the node based containers. Nodes are carved out of slabs
+    // (contiguous blocks of slots) that are requested from the upstream allocator and grow geometrically, freed
+    // nodes go onto a free list to be reused and Release() hands every slab back at once, so tearing down a
+    // container is one deallocation per slab instead of one per node.
+    template <typename T, typename Alloc = Allocator<T>>
+    class NodePool
+    {
+    private:
+        union Slot;
+        struct SlabHeader
+        {
+            Slot* next;
+            usize count;
+        };
+        union Slot
+        {
+            Slot*      next; // While on the free list.
+            SlabHeader slab; // The first slot of every slab links the slabs together.
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+        using SlotAllocator   = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+        using SlotAllocTraits = std::allocator_traits<SlotAllocator>;
+
+    public:
+        static constexpr usize MinSlabSize = std::max<usize>(8, 1024 / sizeof(Slot));
+        static constexpr usize MaxSlabSize = std::max<usize>(MinSlabSize, 64 * 1024 / sizeof(Slot));
+
+    private:
+        [[no_unique_address]] SlotAllocator m_Allocator{};
+        Slot*                               m_Slabs    = nullptr;
+        Slot*                               m_LastSlab = nullptr; // Lets Splice() chain on the slabs of another pool.
+        Slot*                               m_FreeList = nullptr;
+        Slot*                               m_LastFree = nullptr; // Same for the free list.
+        Slot*                               m_Cursor   = nullptr;
+        Slot*                               m_End      = nullptr;
+        usize                               m_SlabSize = MinSlabSize;
+        usize                               m_Capacity = 0; // The slots of all slabs, handed out or not.
+
+    public:
+        NodePool() noexcept = default;
+        explicit NodePool(const Alloc& allocator) noexcept : m_Allocator(allocator) {}
+        NodePool(const NodePool<T, Alloc>&) = delete;
+        NodePool(NodePool<T, Alloc>&& other) noexcept : m_Allocator(std::move(other.m_Allocator))
+        {
+            Steal(other);
+        }
+        ~NodePool() noexcept { Release(); }
+
+    private:
+        void Steal(NodePool<T, Alloc>& other) noexcept
+        {
+            m_Slabs    = std::exchange(other.m_Slabs, nullptr);
+            m_LastSlab = std::exchange(other.m_LastSlab, nullptr);
+            m_FreeList = std::exchange(other.m_FreeList, nullptr);
+            m_LastFree = std::exchange(other.m_LastFree, nullptr);
+            m_Cursor   = std::exchange(other.m_Cursor, nullptr);
+            m_End      = std::exchange(other.m_End, nullptr);
+            m_SlabSize = std::exchange(other.m_SlabSize, MinSlabSize);
+            m_Capacity = std::exchange(other.m_Capacity, 0);
+        }
+        void NewSlab()
+        {
+            // Slot 0 is the header, the rest is handed out front to back.
+            Slot* slab       = SlotAllocTraits::allocate(m_Allocator, m_SlabSize);
+            slab->slab.next  = m_Slabs;
+            slab->slab.count = m_SlabSize;
+            if (!m_Slabs)
+                m_LastSlab = slab;
+            m_Slabs     = slab;
+            m_Cursor    = slab + 1;
+            m_End       = slab + m_SlabSize;
+            m_Capacity += m_SlabSize - 1;
+            m_SlabSize  = std::min(m_SlabSize * 2, MaxSlabSize);
+        }
+
+    public:
+        constexpr const SlotAllocator& GetAllocator() const noexcept { return m_Allocator; }
+        constexpr usize                Capacity() const noexcept { return m_Capacity; }
+        // Whether live nodes fill at least half of the slots, so handing the pool to Splice() keeps at most as
+        // much memory alive again as is in use. Sparser pools are better off moving their nodes one by one.
+        constexpr bool IsDense(const usize live) const noexcept { return live >= m_Capacity - live; }
+
+    public:
+        // Returns uninitialized storage for a single T.
+        [[nodiscard]] T* Allocate()
+        {
+            if (m_FreeList)
+            {
+                Slot* slot = m_FreeList;
+                m_FreeList = slot->next;
+                if (!m_FreeList)
+                    m_LastFree = nullptr;
+                return reinterpret_cast<T*>(slot->storage);
+            }
+            if (m_Cursor == m_End)
+                NewSlab();
+            return reinterpret_cast<T*>((m_Cursor++)->storage);
+        }
+        // Puts the storage of an already destroyed T back onto the free list.
+        void Deallocate(T* ptr) noexcept
+        {
+            Slot* slot = reinterpret_cast<Slot*>(ptr);
+            slot->next = m_FreeList;
+            if (!m_FreeList)
+                m_LastFree = slot;
+            m_FreeList = slot;
+        }
+        // Hands every slab back to the upstream allocator. Whatever still lives in the pool must have been
+        // destroyed already (or be trivially destructible).
+        void Release() noexcept
+        {
+            while (m_Slabs)
+            {
+                Slot* next = m_Slabs->slab.next;
+                SlotAllocTraits::deallocate(m_Allocator, m_Slabs, m_Slabs->slab.count);
+                m_Slabs = next;
+            }
+            m_LastSlab = nullptr;
+            m_FreeList = nullptr;
+            m_LastFree = nullptr;
+            m_Cursor   = nullptr;
+            m_End      = nullptr;
+            m_SlabSize = MinSlabSize;
+            m_Capacity = 0;
+        }
+        // Releases the pool and switches over to allocator, only meant for copy assignment of containers
+        // whose allocator propagates.
+        void Reset(const Alloc& allocator) noexcept
+        {
+            Release();
+            m_Allocator = SlotAllocator(allocator);
+        }
+        void Swap(NodePool<T, Alloc>& other) noexcept
+        {
+            if constexpr (SlotAllocTraits::propagate_on_container_swap::value)
+                std::swap(m_Allocator, other.m_Allocator);
+            std::swap(m_Slabs, other.m_Slabs);
+            std::swap(m_LastSlab, other.m_LastSlab);
+            std::swap(m_FreeList, other.m_FreeList);
+            std::swap(m_LastFree, other.m_LastFree);
+            std::swap(m_Cursor, other.m_Cursor);
+            std::swap(m_End, other.m_End);
+            std::swap(m_SlabSize, other.m_SlabSize);
+            std::swap(m_Capacity, other.m_Capacity);
+        }
+        // Takes over the slabs of other, whose allocator must compare equal to ours, so the nodes other handed
+        // out are from then on deallocated to and released by this pool. O(1), the slots other never handed out
+        // stay unused until Release(), so check IsDense() first.
+        void Splice(NodePool<T, Alloc>& other) noexcept
+        {
+            if (&other == this)
+                return;
+
+            if (other.m_Slabs)
+            {
+                other.m_LastSlab->slab.next = m_Slabs;
+                if (!m_Slabs)
+                    m_LastSlab = other.m_LastSlab;
+                m_Slabs = other.m_Slabs;
+            }
+            if (other.m_FreeList)
+            {
+                other.m_LastFree->next = m_FreeList;
+                if (!m_FreeList)
+                    m_LastFree = other.m_LastFree;
+                m_FreeList = other.m_FreeList;
+            }
+            m_Capacity += other.m_Capacity;
+
+            other.m_Slabs    = nullptr;
+            other.m_LastSlab = nullptr;
+            other.m_FreeList = nullptr;
+            other.m_LastFree = nullptr;
+            other.m_Cursor   = nullptr;
+            other.m_End      = nullptr;
+            other.m_SlabSize = MinSlabSize;
+            other.m_Capacity = 0;
+        }
+
+    public:
+        NodePool<T, Alloc>& operator=(const NodePool<T, Alloc>&) = delete;
+        // Takes over the slabs of other, which must either propagate its allocator on move assignment or
+        // compare equal to ours.
+        NodePool<T, Alloc>& operator=(NodePool<T, Alloc>&& other) noexcept
+        {
+            if (&other == this)
+                return *this;
+
+            Release();
+            if constexpr (SlotAllocTraits::propagate_on_container_move_assignment::value)
+                m_Allocator = std::move(other.m_Allocator);
+            Steal(other);
+            return *this;
+        }
+    };
+} // namespace my
+
+#endif // MY_NODE_POOL_H
@@ -9,48 +9,62 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 
 #include <CommonDef.h>
 
+#include "../Memory/Allocator.h"
+
 namespace stl {
-    template <typename T>
+    template <typename T, typename Alloc = my::Allocator<T>>
     class Queue
     {
     private:
-        T*    m_Buffer       = nullptr;
-        usize m_Size         = 0;
-        usize m_Capacity     = 0;
-        usize m_IndexPointer = 0;
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+    private:
+        [[no_unique_address]] Alloc m_Allocator{};
+        T*                          m_Buffer       = nullptr;
+        usize                       m_Size         = 0;
+        usize                       m_Capacity     = 0;
+        usize                       m_IndexPointer = 0;
 
     public:
         Queue() noexcept;
-        Queue(const std::initializer_list<T> list) noexcept;
-        Queue(const Queue<T>& other) noexcept;
-        Queue(Queue<T>&& other) noexcept;
+        explicit Queue(const Alloc& allocator) noexcept;
+        Queue(const std::initializer_list<T> list, const Alloc& allocator = Alloc());
+        Queue(const Queue<T, Alloc>& other);
+        Queue(Queue<T, Alloc>&& other) noexcept;
         ~Queue() noexcept;
 
     public:
         constexpr usize Size() const noexcept { return m_Size - m_IndexPointer; }
         constexpr bool  Empty() const noexcept { return Size() == 0; }
+        constexpr Alloc GetAllocator() const noexcept { return m_Allocator; }
 
     private:
-        void           Realloc(const usize newSize);
-        constexpr void Drop() noexcept;
+        void Realloc(const usize newCapacity);
+        void Drop() noexcept;
 
     public:
         void Push(const T& e);
+        void Push(T&& e);
+        template <typename... TArgs>
+        T&   Emplace(TArgs&&... args);
         T    Pop();
         T&   Front();
         T&   Back();
-        void Swap(Queue<T>& other) noexcept;
+        void Swap(Queue<T, Alloc>& other) noexcept;
 
     public:
-        inline Queue<T>& operator=(const Queue<T>& other);
-        inline Queue<T>& operator=(Queue<T>&& other) noexcept;
-        inline Queue<T>& operator=(const std::initializer_list<T> other) noexcept;
+        inline Queue<T, Alloc>& operator=(const Queue<T, Alloc>& other);
+        inline Queue<T, Alloc>& operator=(Queue<T, Alloc>&& other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value);
+        inline Queue<T, Alloc>& operator=(const std::initializer_list<T> other);
 
     public:
-        friend std::ostream& operator<<(std::ostream& stream, const Queue<T>& other) noexcept
+        friend std::ostream& operator<<(std::ostream& stream, const Queue<T, Alloc>& other) noexcept
         {
             const auto size = other.Size();
 
@@ -68,6 +82,11 @@ namespace stl {
     };
 } // namespace stl
 
+namespace stl::pmr {
+    template <typename T>
+    using Queue = stl::Queue<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace stl::pmr
+
 // FIXME: Uncomment
 #include "Queue.hpp"
 #endif // QUEUE_H
@@ -2,31 +2,56 @@
 #define QUEUE_IMPL_H
 
 namespace stl {
-    template <typename T>
-    Queue<T>::Queue() noexcept = default;
+    template <typename T, typename Alloc>
+    Queue<T, Alloc>::Queue() noexcept = default;
 
-    template <typename T>
-    Queue<T>::Queue(const std::initializer_list<T> list) noexcept
+    template <typename T, typename Alloc>
+    Queue<T, Alloc>::Queue(const Alloc& allocator) noexcept : m_Allocator(allocator)
     {
-        Realloc(list.size());
-        std::copy(list.begin(), list.end(), m_Buffer);
     }
 
-    template <typename T>
-    Queue<T>::Queue(const Queue<T>& other) noexcept
+    template <typename T, typename Alloc>
+    Queue<T, Alloc>::Queue(const std::initializer_list<T> list, const Alloc& allocator) : m_Allocator(allocator)
     {
-        if (other.m_Buffer)
+        Realloc(list.size() * 2);
+        try
         {
-            m_Size         = other.m_Size;
-            m_Capacity     = other.m_Capacity;
-            m_IndexPointer = other.m_IndexPointer;
-            m_Buffer       = new T[m_Capacity];
-            std::memcpy(m_Buffer, other.m_Buffer, m_Size * sizeof(T));
+            for (const auto& e : list)
+            {
+                AllocTraits::construct(m_Allocator, m_Buffer + m_Size, e);
+                ++m_Size;
+            }
+        }
+        catch (...)
+        {
+            // The destructor does not run for a constructor that throws.
+            Drop();
+            throw;
         }
     }
 
-    template <typename T>
-    Queue<T>::Queue(Queue<T>&& other) noexcept
+    template <typename T, typename Alloc>
+    Queue<T, Alloc>::Queue(const Queue<T, Alloc>& other)
+        : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator))
+    {
+        Realloc(other.m_Capacity);
+        try
+        {
+            for (usize i = other.m_IndexPointer; i < other.m_Size; ++i)
+            {
+                AllocTraits::construct(m_Allocator, m_Buffer + m_Size, other.m_Buffer[i]);
+                ++m_Size;
+            }
+        }
+        catch (...)
+        {
+            Drop();
+            throw;
+        }
+    }
+
+    template <typename T, typename Alloc>
+    Queue<T, Alloc>::Queue(Queue<T, Alloc>&& other) noexcept : m_Allocator(std::move(other.m_Allocator))
     {
         if (other.m_Buffer)
         {
@@ -42,129 +67,168 @@ namespace stl {
         }
     }
 
-    template <typename T>
-    Queue<T>::~Queue() noexcept
+    template <typename T, typename Alloc>
+    Queue<T, Alloc>::~Queue() noexcept
     {
         Drop();
     }
 
-    template <typename T>
-    void Queue<T>::Realloc(const usize newSize)
+    template <typename T, typename Alloc>
+    void Queue<T, Alloc>::Realloc(const usize newCapacity)
     {
-        if (newSize == m_Size)
-            return;
-
-        if (m_Buffer)
-        {
-            if (m_IndexPointer >= m_Capacity / 2)
-            {
-                for (usize j = 0, i = m_IndexPointer; i < m_Size - m_IndexPointer; ++i)
-                    m_Buffer[j++] = std::move(m_Buffer[i]);
-                m_IndexPointer = 0;
-                m_Size         = newSize;
-            }
-            else
-            {
-                // TODO: Consider shrinkage perhaps?
-                const auto* temp      = m_Buffer;
-                const auto  prev_size = m_Size;
+        const usize size = Size();
+        T*          dest = m_Buffer;
 
-                m_Size     = newSize;
-                m_Capacity = m_Size * 2;
-                m_Buffer   = new T[m_Capacity];
-                std::memcpy(m_Buffer, temp, prev_size * sizeof(T));
+        // If the popped off front takes up enough of the buffer just slide the live elements back to the
+        // beginning instead of allocating a bigger buffer.
+        if (newCapacity > m_Capacity)
+            dest = AllocTraits::allocate(m_Allocator, newCapacity);
 
-                delete[] temp;
-            }
+        for (usize i = 0; i < size; ++i)
+        {
+            AllocTraits::construct(m_Allocator, dest + i, std::move_if_noexcept(m_Buffer[m_IndexPointer + i]));
+            std::destroy_at(m_Buffer + m_IndexPointer + i);
         }
-        else
+
+        if (dest != m_Buffer)
         {
-            m_Size     = newSize;
-            m_Capacity = m_Size * 2;
-            m_Buffer   = new T[m_Capacity];
+            if (m_Buffer)
+                AllocTraits::deallocate(m_Allocator, m_Buffer, m_Capacity);
+            m_Buffer   = dest;
+            m_Capacity = newCapacity;
         }
+        m_Size         = size;
+        m_IndexPointer = 0;
+    }
+
+    template <typename T, typename Alloc>
+    void Queue<T, Alloc>::Drop() noexcept
+    {
+        std::destroy(m_Buffer + m_IndexPointer, m_Buffer + m_Size);
+        if (m_Buffer)
+            AllocTraits::deallocate(m_Allocator, m_Buffer, m_Capacity);
+        m_Buffer       = nullptr;
+        m_Size         = 0;
+        m_Capacity     = 0;
+        m_IndexPointer = 0;
+    }
+
+    template <typename T, typename Alloc>
+    void Queue<T, Alloc>::Push(const T& e)
+    {
+        Emplace(e);
     }
 
-    template <typename T>
-    constexpr void Queue<T>::Drop() noexcept
+    template <typename T, typename Alloc>
+    void Queue<T, Alloc>::Push(T&& e)
     {
-        delete[] m_Buffer;
-        m_Buffer   = nullptr;
-        m_Size     = 0;
-        m_Capacity = 0;
+        Emplace(std::move(e));
     }
 
-    template <typename T>
-    void Queue<T>::Push(const T& e)
+    template <typename T, typename Alloc>
+    template <typename... TArgs>
+    T& Queue<T, Alloc>::Emplace(TArgs&&... args)
     {
         if (m_Size >= m_Capacity)
         {
-            Realloc(m_Size + 1);
-            m_Buffer[m_Size - 1] = e;
+            // args may refer to one of our own elements so build the new one before anything moves.
+            T obj(std::forward<TArgs>(args)...);
+            if (m_IndexPointer >= m_Capacity / 2 && m_IndexPointer > 0)
+                Realloc(m_Capacity);
+            else
+                Realloc((Size() + 1) * 2);
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size, std::move(obj));
         }
         else
-            m_Buffer[m_Size++] = e;
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size, std::forward<TArgs>(args)...);
+        return m_Buffer[m_Size++];
     }
 
-    template <typename T>
-    T Queue<T>::Pop()
+    template <typename T, typename Alloc>
+    T Queue<T, Alloc>::Pop()
     {
         if (Size() <= 0)
             throw std::out_of_range("Tried calling Pop() on an empty Queue.");
-        return std::move(m_Buffer[m_IndexPointer++]);
+
+        T obj = std::move(m_Buffer[m_IndexPointer]);
+        std::destroy_at(m_Buffer + m_IndexPointer++);
+
+        // Once drained, start over from the beginning of the buffer.
+        if (m_IndexPointer == m_Size)
+        {
+            m_IndexPointer = 0;
+            m_Size         = 0;
+        }
+        return obj;
     }
 
-    template <typename T>
-    T& Queue<T>::Front()
+    template <typename T, typename Alloc>
+    T& Queue<T, Alloc>::Front()
     {
         if (Size() <= 0)
             throw std::out_of_range("Tried calling Front() on an empty Queue.");
         return m_Buffer[m_IndexPointer];
     }
 
-    template <typename T>
-    T& Queue<T>::Back()
+    template <typename T, typename Alloc>
+    T& Queue<T, Alloc>::Back()
     {
         if (Size() <= 0)
             throw std::out_of_range("Tried calling Front() on an empty Queue.");
         return m_Buffer[m_Size - 1];
     }
 
-    template <typename T>
-    void Queue<T>::Swap(Queue<T>& other) noexcept
+    template <typename T, typename Alloc>
+    void Queue<T, Alloc>::Swap(Queue<T, Alloc>& other) noexcept
     {
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+            std::swap(m_Allocator, other.m_Allocator);
         std::swap(m_Buffer, other.m_Buffer);
         std::swap(m_Size, other.m_Size);
         std::swap(m_Capacity, other.m_Capacity);
         std::swap(m_IndexPointer, other.m_IndexPointer);
     }
 
-    template <typename T>
-    inline Queue<T>& Queue<T>::operator=(const Queue<T>& other)
+    template <typename T, typename Alloc>
+    inline Queue<T, Alloc>& Queue<T, Alloc>::operator=(const Queue<T, Alloc>& other)
     {
         if (&other == this)
             return *this;
 
-        if (other.m_Buffer)
-        {
-            if (m_Buffer)
-                Drop();
-
-            m_Size         = other.m_Size;
-            m_Capacity     = other.m_Capacity;
-            m_IndexPointer = other.m_IndexPointer;
-            m_Buffer       = new T[m_Capacity];
-            std::memcpy(m_Buffer, other.m_Buffer, m_Size * sizeof(T));
-        }
+        Drop();
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            m_Allocator = other.m_Allocator;
+        Realloc(other.m_Capacity);
+        for (usize i = other.m_IndexPointer; i < other.m_Size; ++i)
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size++, other.m_Buffer[i]);
         return *this;
     }
 
-    template <typename T>
-    inline Queue<T>& Queue<T>::operator=(Queue<T>&& other) noexcept
+    template <typename T, typename Alloc>
+    inline Queue<T, Alloc>& Queue<T, Alloc>::operator=(Queue<T, Alloc>&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
     {
         if (&other == this)
             return *this;
 
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value &&
+                      !AllocTraits::is_always_equal::value)
+        {
+            // The buffer belongs to a different memory resource, so the elements have to be moved one by one.
+            if (m_Allocator != other.m_Allocator)
+            {
+                Drop();
+                Realloc(other.Size());
+                for (usize i = other.m_IndexPointer; i < other.m_Size; ++i)
+                    AllocTraits::construct(m_Allocator, m_Buffer + m_Size++, std::move(other.m_Buffer[i]));
+                other.Drop();
+                return *this;
+            }
+        }
+
+        Drop();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            m_Allocator = std::move(other.m_Allocator);
         if (other.m_Buffer)
         {
             m_Buffer       = other.m_Buffer;
@@ -179,6 +243,18 @@ namespace stl {
         }
         return *this;
     }
+
+    template <typename T, typename Alloc>
+    inline Queue<T, Alloc>& Queue<T, Alloc>::operator=(const std::initializer_list<T> list)
+    {
+        std::destroy(m_Buffer + m_IndexPointer, m_Buffer + m_Size);
+        m_Size         = 0;
+        m_IndexPointer = 0;
+        Realloc(list.size() * 2);
+        for (const auto& e : list)
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size++, e);
+        return *this;
+    }
 } // namespace stl
 
 #endif // QUEUE_IMPL_H
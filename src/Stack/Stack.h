@@ -9,17 +9,25 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 
 #include <CommonDef.h>
 
+#include "../Memory/Allocator.h"
+
 namespace stl {
-    template <typename T>
+    template <typename T, typename Alloc = my::Allocator<T>>
     class Stack
     {
     private:
-        T*    m_Buffer   = nullptr;
-        usize m_Size     = 0;
-        usize m_Capacity = 0;
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+    private:
+        [[no_unique_address]] Alloc m_Allocator{};
+        T*                          m_Buffer   = nullptr;
+        usize                       m_Size     = 0;
+        usize                       m_Capacity = 0;
 
     public:
         class ConstIterator;
@@ -127,10 +135,11 @@ namespace stl {
 
     public:
         Stack();
-        Stack(const usize size);
-        Stack(const std::initializer_list<T> list);
-        Stack(const Stack<T>& other);
-        Stack(Stack<T>&& other);
+        explicit Stack(const Alloc& allocator) noexcept;
+        Stack(const usize size, const Alloc& allocator = Alloc());
+        Stack(const std::initializer_list<T> list, const Alloc& allocator = Alloc());
+        Stack(const Stack<T, Alloc>& other);
+        Stack(Stack<T, Alloc>&& other) noexcept;
         ~Stack();
 
     public:
@@ -139,6 +148,7 @@ namespace stl {
         constexpr bool  Empty() const noexcept { return m_Size == 0; }
         constexpr T*    Data() const noexcept { return m_Buffer; }
         constexpr usize MaxSize() const noexcept { return std::numeric_limits<usize>::max() / sizeof(T); }
+        constexpr Alloc GetAllocator() const noexcept { return m_Allocator; }
 
     public:
         inline Iterator      begin() noexcept { return Iterator(m_Buffer); }
@@ -147,27 +157,29 @@ namespace stl {
         inline ConstIterator end() const noexcept { return ConstIterator(m_Buffer + m_Size); }
 
     private:
-        void        Realloc(const usize newSize, const bool reserveExtra = true);
+        void        Realloc(const usize newCapacity);
         inline void Drop() noexcept;
 
     public:
         void            Push(const T& e);
+        void            Push(T&& e);
         inline T        Pop();
         inline T&       Top();
         inline const T& Top() const;
-        constexpr void  Swap(Stack<T>& other);
+        constexpr void  Swap(Stack<T, Alloc>& other) noexcept;
 
     public:
         template <typename... TArgs>
-        void Emplace(TArgs&&... args);
+        T& Emplace(TArgs&&... args);
 
     public:
-        inline Stack<T>& operator=(const std::initializer_list<T> list);
-        inline Stack<T>& operator=(const Stack<T>& other);
-        inline Stack<T>& operator=(Stack<T>&& other) noexcept;
+        inline Stack<T, Alloc>& operator=(const std::initializer_list<T> list);
+        inline Stack<T, Alloc>& operator=(const Stack<T, Alloc>& other);
+        inline Stack<T, Alloc>& operator=(Stack<T, Alloc>&& other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value);
 
     public:
-        friend std::ostream& operator<<(std::ostream& stream, const Stack<T>& other) noexcept
+        friend std::ostream& operator<<(std::ostream& stream, const Stack<T, Alloc>& other) noexcept
         {
             stream << "[ ";
             for (usize i = 0; i < other.m_Size; ++i)
@@ -183,6 +195,11 @@ namespace stl {
     };
 } // namespace stl
 
+namespace stl::pmr {
+    template <typename T>
+    using Stack = stl::Stack<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace stl::pmr
+
 // FIXME: Uncomment
 #include "Stack.hpp"
 #endif // STACK_H
@@ -4,45 +4,70 @@
 #include "Stack.h"
 
 namespace stl {
-    template <typename T>
-    Stack<T>::Stack() = default;
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::Stack() = default;
 
-    template <typename T>
-    Stack<T>::Stack(const usize size) : m_Size(size), m_Capacity(size * 2), m_Buffer(new T[m_Capacity])
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::Stack(const Alloc& allocator) noexcept : m_Allocator(allocator)
     {
     }
 
-    template <typename T>
-    Stack<T>::Stack(const std::initializer_list<T> list)
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::Stack(const usize size, const Alloc& allocator) : m_Allocator(allocator)
     {
-        m_Size     = list.size();
-        m_Capacity = m_Size * 2;
-        m_Buffer   = new T[m_Capacity];
-        if (!m_Buffer)
-            throw std::bad_alloc();
-        std::copy(list.begin(), list.end(), m_Buffer);
+        Realloc(size * 2);
+        try
+        {
+            for (; m_Size < size; ++m_Size)
+                AllocTraits::construct(m_Allocator, m_Buffer + m_Size);
+        }
+        catch (...)
+        {
+            // The destructor does not run for a constructor that throws.
+            Drop();
+            throw;
+        }
     }
 
-    template <typename T>
-    Stack<T>::Stack(const Stack<T>& other)
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::Stack(const std::initializer_list<T> list, const Alloc& allocator) : m_Allocator(allocator)
     {
-        if (&other == this)
-            return;
-
-        m_Size     = other.m_Size;
-        m_Capacity = other.m_Capacity;
-        m_Buffer   = new T[m_Capacity];
-        if (!m_Buffer)
-            throw std::bad_alloc();
-        std::memcpy(m_Buffer, other.m_Buffer, m_Size * sizeof(T));
+        Realloc(list.size() * 2);
+        try
+        {
+            for (const auto& e : list)
+            {
+                AllocTraits::construct(m_Allocator, m_Buffer + m_Size, e);
+                ++m_Size;
+            }
+        }
+        catch (...)
+        {
+            Drop();
+            throw;
+        }
     }
 
-    template <typename T>
-    Stack<T>::Stack(Stack<T>&& other)
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::Stack(const Stack<T, Alloc>& other)
+        : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator))
     {
-        if (&other == this)
-            return;
+        Realloc(other.m_Capacity);
+        try
+        {
+            for (; m_Size < other.m_Size; ++m_Size)
+                AllocTraits::construct(m_Allocator, m_Buffer + m_Size, other.m_Buffer[m_Size]);
+        }
+        catch (...)
+        {
+            Drop();
+            throw;
+        }
+    }
 
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::Stack(Stack<T, Alloc>&& other) noexcept : m_Allocator(std::move(other.m_Allocator))
+    {
         m_Size           = other.m_Size;
         m_Capacity       = other.m_Capacity;
         other.m_Size     = 0;
@@ -50,147 +75,180 @@ namespace stl {
         std::swap(m_Buffer, other.m_Buffer);
     }
 
-    template <typename T>
-    Stack<T>::~Stack()
+    template <typename T, typename Alloc>
+    Stack<T, Alloc>::~Stack()
     {
         Drop();
     }
 
-    template <typename T>
-    void Stack<T>::Realloc(const usize newSize, const bool reserveExtra)
+    template <typename T, typename Alloc>
+    void Stack<T, Alloc>::Realloc(const usize newCapacity)
     {
-        if (newSize == m_Size)
+        if (newCapacity <= m_Capacity)
             return;
 
-        const usize prev_size = m_Size;
-        m_Size                = newSize;
-
-        if (reserveExtra)
-            m_Capacity = newSize * 2;
-        else
-            m_Capacity = newSize;
-
-        if (prev_size > 0)
+        // Only the storage is allocated here, the elements are moved over (or copied if their move constructor
+        // may throw) and everything past m_Size stays uninitialized.
+        T* buffer = AllocTraits::allocate(m_Allocator, newCapacity);
+        try
         {
-            T* temp  = m_Buffer;
-            m_Buffer = new T[m_Capacity];
-            if (!m_Buffer)
-                throw std::bad_alloc();
-            if (prev_size < m_Size)
-                std::memcpy(m_Buffer, temp, prev_size * sizeof(T));
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                std::uninitialized_move_n(m_Buffer, m_Size, buffer);
             else
-                std::memcpy(m_Buffer, temp, m_Size * sizeof(T));
-            delete[] temp;
+                std::uninitialized_copy_n(m_Buffer, m_Size, buffer);
         }
-        else
+        catch (...)
         {
-            if (m_Buffer)
-                delete[] m_Buffer;
-            m_Buffer = new T[m_Capacity];
-            if (!m_Buffer)
-                throw std::bad_alloc();
+            AllocTraits::deallocate(m_Allocator, buffer, newCapacity);
+            throw;
         }
+
+        std::destroy_n(m_Buffer, m_Size);
+        if (m_Buffer)
+            AllocTraits::deallocate(m_Allocator, m_Buffer, m_Capacity);
+        m_Buffer   = buffer;
+        m_Capacity = newCapacity;
     }
 
-    template <typename T>
-    inline void Stack<T>::Drop() noexcept
+    template <typename T, typename Alloc>
+    inline void Stack<T, Alloc>::Drop() noexcept
     {
-        delete[] m_Buffer;
+        std::destroy_n(m_Buffer, m_Size);
+        if (m_Buffer)
+            AllocTraits::deallocate(m_Allocator, m_Buffer, m_Capacity);
         m_Buffer   = nullptr;
         m_Size     = 0;
         m_Capacity = 0;
     }
 
-    template <typename T>
-    void Stack<T>::Push(const T& e)
+    template <typename T, typename Alloc>
+    void Stack<T, Alloc>::Push(const T& e)
     {
-        if (m_Size >= m_Capacity)
-        {
-            Realloc(m_Size + 1);
-            m_Buffer[m_Size - 1] = e;
-        }
-        else
-            m_Buffer[m_Size++] = e;
+        Emplace(e);
+    }
+
+    template <typename T, typename Alloc>
+    void Stack<T, Alloc>::Push(T&& e)
+    {
+        Emplace(std::move(e));
     }
 
-    template <typename T>
-    inline T Stack<T>::Pop()
+    template <typename T, typename Alloc>
+    inline T Stack<T, Alloc>::Pop()
     {
         if (m_Size > 0)
-            return std::move(m_Buffer[m_Size--]);
+        {
+            T obj = std::move(m_Buffer[--m_Size]);
+            std::destroy_at(m_Buffer + m_Size);
+            return obj;
+        }
         else
             throw std::out_of_range("Tried calling Pop() on an empty vector.");
     }
 
-    template <typename T>
-    inline T& Stack<T>::Top()
+    template <typename T, typename Alloc>
+    inline T& Stack<T, Alloc>::Top()
     {
         if (m_Size > 0)
-            return m_Buffer[0];
+            return m_Buffer[m_Size - 1];
         else
             throw std::out_of_range("Tried calling Front() on an empty vector.");
     }
 
-    template <typename T>
-    inline const T& Stack<T>::Top() const
+    template <typename T, typename Alloc>
+    inline const T& Stack<T, Alloc>::Top() const
     {
         if (m_Size > 0)
-            return m_Buffer[0];
+            return m_Buffer[m_Size - 1];
         else
             throw std::out_of_range("Tried calling Front() on an empty vector.");
     }
 
-    template <typename T>
-    constexpr void Stack<T>::Swap(Stack<T>& other)
+    template <typename T, typename Alloc>
+    constexpr void Stack<T, Alloc>::Swap(Stack<T, Alloc>& other) noexcept
     {
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+            std::swap(m_Allocator, other.m_Allocator);
         std::swap(m_Size, other.m_Size);
         std::swap(m_Capacity, other.m_Capacity);
         std::swap(m_Buffer, other.m_Buffer);
     }
 
-    template <typename T>
+    template <typename T, typename Alloc>
     template <typename... TArgs>
-    void Stack<T>::Emplace(TArgs&&... args)
+    T& Stack<T, Alloc>::Emplace(TArgs&&... args)
     {
-        const T* temp = m_Buffer;
-
-        ++m_Size;
-        m_Capacity = m_Size * 2;
-        m_Buffer   = new T[m_Capacity];
-
-        std::copy(temp, temp, m_Buffer);
-        m_Buffer[0] = T(std::forward<TArgs>(args)...);
-        std::copy(temp, temp + m_Size - 1, m_Buffer + 1);
-
-        delete[] temp;
+        if (m_Size >= m_Capacity)
+        {
+            // args may refer to one of our own elements so build the new one before the buffer moves.
+            T obj(std::forward<TArgs>(args)...);
+            Realloc((m_Size + 1) * 2);
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size, std::move(obj));
+        }
+        else
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size, std::forward<TArgs>(args)...);
+        return m_Buffer[m_Size++];
     }
 
-    template <typename T>
-    inline Stack<T>& Stack<T>::operator=(const std::initializer_list<T> list)
+    template <typename T, typename Alloc>
+    inline Stack<T, Alloc>& Stack<T, Alloc>::operator=(const std::initializer_list<T> list)
     {
-        Realloc(list.size());
-        std::copy(list.begin(), list.end(), begin());
+        std::destroy_n(m_Buffer, m_Size);
+        m_Size = 0;
+        Realloc(list.size() * 2);
+        for (const auto& e : list)
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size++, e);
         return *this;
     }
 
-    template <typename T>
-    inline Stack<T>& Stack<T>::operator=(const Stack<T>& other)
+    template <typename T, typename Alloc>
+    inline Stack<T, Alloc>& Stack<T, Alloc>::operator=(const Stack<T, Alloc>& other)
     {
         if (&other == this)
             return *this;
 
-        Realloc(other.m_Size);
-        std::memcpy(m_Buffer, other.m_Buffer, m_Size * sizeof(T));
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            Drop();
+            m_Allocator = other.m_Allocator;
+        }
+        else
+        {
+            std::destroy_n(m_Buffer, m_Size);
+            m_Size = 0;
+        }
+        Realloc(other.m_Capacity);
+        for (; m_Size < other.m_Size; ++m_Size)
+            AllocTraits::construct(m_Allocator, m_Buffer + m_Size, other.m_Buffer[m_Size]);
         return *this;
     }
 
-    template <typename T>
-    inline Stack<T>& Stack<T>::operator=(Stack<T>&& other) noexcept
+    template <typename T, typename Alloc>
+    inline Stack<T, Alloc>& Stack<T, Alloc>::operator=(Stack<T, Alloc>&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
     {
         if (&other == this)
             return *this;
 
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value &&
+                      !AllocTraits::is_always_equal::value)
+        {
+            // The buffer belongs to a different memory resource, so the elements have to be moved one by one.
+            if (m_Allocator != other.m_Allocator)
+            {
+                std::destroy_n(m_Buffer, m_Size);
+                m_Size = 0;
+                Realloc(other.m_Size);
+                for (; m_Size < other.m_Size; ++m_Size)
+                    AllocTraits::construct(m_Allocator, m_Buffer + m_Size, std::move(other.m_Buffer[m_Size]));
+                other.Drop();
+                return *this;
+            }
+        }
+
         Drop();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            m_Allocator = std::move(other.m_Allocator);
         m_Size           = other.m_Size;
         m_Capacity       = other.m_Capacity;
         other.m_Size     = 0;
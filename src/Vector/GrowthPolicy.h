@@ -0,0 +1,86 @@
+#ifndef MY_GROWTH_POLICY_H
+#define MY_GROWTH_POLICY_H
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <limits>
+
+#include <CommonDef.h>
+
+namespace my {
+    // A growth policy decides how many elements a container should make room for once it runs out of
+    // capacity. Grow() receives the current capacity, the minimum capacity that is required and the size
+    // of a single element in bytes, and must return a capacity of at least the required amount.
+    template <typename T>
+    concept IsGrowthPolicy = requires(const usize capacity, const usize required, const usize elementSize) {
+        {
+            T::Grow(capacity, required, elementSize)
+        } -> std::convertible_to<usize>;
+    };
+
+    // Multiplies the current capacity by Numerator / Denominator, which is what gives Push() its amortized
+    // O(1) complexity.
+    template <usize Numerator, usize Denominator = 1>
+        requires(Numerator > Denominator && Denominator > 0)
+    struct GeometricGrowth
+    {
+        static constexpr usize Grow(const usize capacity, const usize required, const usize elementSize) noexcept
+        {
+            const usize max_capacity = std::numeric_limits<usize>::max() / elementSize;
+            const usize extra        = capacity / Denominator * (Numerator - Denominator) +
+                                capacity % Denominator * (Numerator - Denominator) / Denominator;
+            const usize grown        = (capacity > max_capacity - extra) ? max_capacity : capacity + extra;
+            return std::max(grown, required);
+        }
+    };
+
+    using DoublingGrowth = GeometricGrowth<2>;
+    using HalfGrowth     = GeometricGrowth<3, 2>;
+
+    // Grows with Base and then rounds the size of the buffer up to a whole number of pages, handy for big
+    // buffers where the allocator maps fresh pages anyway.
+    template <usize PageSize = 4096, IsGrowthPolicy Base = DoublingGrowth>
+        requires(std::has_single_bit(PageSize))
+    struct PageGrowth
+    {
+        static constexpr usize Grow(const usize capacity, const usize required, const usize elementSize) noexcept
+        {
+            const usize grown = Base::Grow(capacity, required, elementSize);
+            if (grown > (std::numeric_limits<usize>::max() - PageSize) / elementSize)
+                return grown;
+
+            const usize bytes = (grown * elementSize + PageSize - 1) & ~(PageSize - 1);
+            return bytes / elementSize;
+        }
+    };
+
+    // Grows with Base and then rounds the size of the buffer up to the next jemalloc style size class
+    // (16 byte quantum, four classes per doubling) so the slack the allocator hands out anyway ends up
+    // as usable capacity instead of going to waste.
+    template <IsGrowthPolicy Base = DoublingGrowth>
+    struct SizeClassGrowth
+    {
+        static constexpr usize RoundToSizeClass(const usize bytes) noexcept
+        {
+            if (bytes <= 16)
+                return (bytes + 7) & ~usize(7);
+
+            const usize lg    = std::bit_width(bytes - 1) - 1;
+            const usize delta = std::max<usize>(16, usize(1) << (lg - 2));
+            return (bytes + delta - 1) & ~(delta - 1);
+        }
+        static constexpr usize Grow(const usize capacity, const usize required, const usize elementSize) noexcept
+        {
+            const usize grown = Base::Grow(capacity, required, elementSize);
+            if (grown > std::numeric_limits<usize>::max() / 2 / elementSize)
+                return grown;
+
+            return RoundToSizeClass(grown * elementSize) / elementSize;
+        }
+    };
+
+    using DefaultGrowth = DoublingGrowth;
+} // namespace my
+
+#endif // MY_GROWTH_POLICY_H
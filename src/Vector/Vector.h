@@ -1,28 +1,68 @@
 #ifndef MY_VECTOR_H
 #define MY_VECTOR_H
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <exception>
+#include <functional>
+#include <initializer_list>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <CommonDef.h>
 
+#include "../Memory/Allocator.h"
+#include "GrowthPolicy.h"
+
 namespace my {
+    // Type trait that tells the containers whenever a T can be moved to a new address by simply copying
+    // its bytes and forgetting about the old object. Every trivially copyable type qualifies, specialize it
+    // for your own types (e.g. ones that only hold an owning pointer) to opt them into the memcpy/realloc path.
     template <typename T>
+    struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+    {
+    };
+
+    template <typename T, IsGrowthPolicy Growth = DefaultGrowth, typename Alloc = Allocator<T>>
     class Vec
     {
     private:
-        usize m_Size     = 0;
-        usize m_Capacity = 0;
-        T*    m_Buffer   = nullptr;
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+        // Trivially relocatable elements are grown with a single Reallocate() (if the allocator has one) so the
+        // allocator gets the chance to extend the block in place instead of always copying it.
+        static constexpr bool CanRealloc = IsTriviallyRelocatable<T>::value && IsReallocatingAllocator<Alloc>;
+
+        // The default allocators construct elements with a plain placement new, which lets us hand construction
+        // over to the (memcpy happy) std::uninitialized_* algorithms. Anything else goes through
+        // std::allocator_traits<Alloc>::construct() so e.g. std::pmr allocators propagate to the elements.
+        static constexpr bool HasPlainConstruct =
+            std::is_same_v<Alloc, Allocator<T>> || std::is_same_v<Alloc, std::allocator<T>>;
+
+        // Whenever elements can be slid around inside of the buffer without anything being able to throw midway,
+        // which is what Insert() and Emplace() need to open up a gap in place.
+        static constexpr bool CanShiftInPlace = IsTriviallyRelocatable<T>::value || std::is_nothrow_move_constructible_v<T>;
+
+    private:
+        [[no_unique_address]] Alloc m_Allocator{};
+        usize                       m_Size     = 0;
+        usize                       m_Capacity = 0;
+        T*                          m_Buffer   = nullptr;
 
     public:
         class ConstIterator;
@@ -30,6 +70,7 @@ namespace my {
         {
             friend class ConstIterator;
 
+        public:
             using iterator_category = std::random_access_iterator_tag;
             using difference_type   = ptrdiff;
             using value_type        = T;
@@ -76,6 +117,7 @@ namespace my {
         };
         class ConstIterator
         {
+        public:
             using iterator_category = std::forward_iterator_tag;
             using difference_type   = ptrdiff;
             using value_type        = T;
@@ -130,33 +172,55 @@ namespace my {
 
     public:
         Vec() = default;
-        explicit Vec(const usize size) : m_Size(size), m_Capacity(size * 2), m_Buffer(new T[m_Capacity]) {}
-        Vec(const std::initializer_list<T> list)
+        explicit Vec(const Alloc& allocator) noexcept : m_Allocator(allocator) {}
+        explicit Vec(const usize size, const Alloc& allocator = Alloc())
+            : m_Allocator(allocator), m_Buffer(Allocate(size))
+        {
+            try
+            {
+                ValueConstruct(m_Buffer, size);
+            }
+            catch (...)
+            {
+                Deallocate(m_Buffer, size);
+                throw;
+            }
+            m_Size     = size;
+            m_Capacity = size;
+        }
+        Vec(const std::initializer_list<T> list, const Alloc& allocator = Alloc())
+            : m_Allocator(allocator), m_Buffer(Allocate(list.size()))
         {
+            try
+            {
+                CopyConstruct(list.begin(), list.size(), m_Buffer);
+            }
+            catch (...)
+            {
+                Deallocate(m_Buffer, list.size());
+                throw;
+            }
             m_Size     = list.size();
-            m_Capacity = m_Size * 2;
-            m_Buffer   = new T[m_Capacity];
-            if (!m_Buffer)
-                throw std::bad_alloc();
-            std::copy(list.begin(), list.end(), m_Buffer);
+            m_Capacity = list.size();
         }
-        Vec(const Vec<T>& other)
+        Vec(const Vec<T, Growth, Alloc>& other)
+            : m_Allocator(AllocTraits::select_on_container_copy_construction(other.m_Allocator)),
+              m_Buffer(Allocate(other.m_Size))
         {
-            if (&other == this)
-                return;
-
+            try
+            {
+                CopyConstruct(other.m_Buffer, other.m_Size, m_Buffer);
+            }
+            catch (...)
+            {
+                Deallocate(m_Buffer, other.m_Size);
+                throw;
+            }
             m_Size     = other.m_Size;
-            m_Capacity = other.m_Capacity;
-            m_Buffer   = new T[m_Capacity];
-            if (!m_Buffer)
-                throw std::bad_alloc();
-            std::memcpy(m_Buffer, other.m_Buffer, m_Size * sizeof(T));
+            m_Capacity = other.m_Size;
         }
-        Vec(Vec<T>&& other)
+        Vec(Vec<T, Growth, Alloc>&& other) noexcept : m_Allocator(std::move(other.m_Allocator))
         {
-            if (&other == this)
-                return;
-
             m_Size           = other.m_Size;
             m_Capacity       = other.m_Capacity;
             other.m_Size     = 0;
@@ -171,6 +235,7 @@ namespace my {
         constexpr bool  Empty() const noexcept { return m_Size == 0; }
         constexpr T*    Data() const noexcept { return m_Buffer; }
         constexpr usize MaxSize() const noexcept { return std::numeric_limits<usize>::max() / sizeof(T); }
+        constexpr Alloc GetAllocator() const noexcept { return m_Allocator; }
 
     public:
         inline Iterator      begin() noexcept { return Iterator(m_Buffer); }
@@ -181,63 +246,302 @@ namespace my {
         inline ConstIterator cend() const noexcept { return ConstIterator(m_Buffer + m_Size); }
 
     private:
-        void Realloc(const usize newSize, const bool reserveExtra = true)
+        // Hands out raw, uninitialized storage for `count` elements. Nothing is constructed here, elements
+        // only come to life through placement construction once they are actually pushed.
+        T* Allocate(const usize count)
         {
-            if (newSize == m_Size)
-                return;
-
-            const usize prev_size = m_Size;
-            m_Size                = newSize;
-
-            if (reserveExtra)
-                m_Capacity = newSize * 2;
+            if (count == 0)
+                return nullptr;
+            if (count > MaxSize())
+                throw std::length_error("Vector capacity exceeds MaxSize().");
+            return AllocTraits::allocate(m_Allocator, count);
+        }
+        void Deallocate(T* ptr, const usize count) noexcept
+        {
+            if (ptr)
+                AllocTraits::deallocate(m_Allocator, ptr, count);
+        }
+        template <typename... TArgs>
+        void ConstructAt(T* ptr, TArgs&&... args)
+        {
+            AllocTraits::construct(m_Allocator, ptr, std::forward<TArgs>(args)...);
+        }
+        // Constructs `count` elements at `dest` with `construct(ptr, i)`, tearing down the ones that were already
+        // built if one of them throws.
+        template <typename Fn>
+        static void ConstructN(T* dest, const usize count, Fn&& construct)
+        {
+            usize i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                    construct(dest + i, i);
+            }
+            catch (...)
+            {
+                std::destroy_n(dest, i);
+                throw;
+            }
+        }
+        template <typename It>
+        void CopyConstruct(It first, const usize count, T* dest)
+        {
+            if constexpr (HasPlainConstruct)
+                std::uninitialized_copy_n(first, count, dest);
             else
-                m_Capacity = newSize;
-
-            if (prev_size > 0)
+                ConstructN(dest, count, [&](T* ptr, usize) { ConstructAt(ptr, *first++); });
+        }
+        void FillConstruct(T* dest, const usize count, const T& value)
+        {
+            if constexpr (HasPlainConstruct)
+                std::uninitialized_fill_n(dest, count, value);
+            else
+                ConstructN(dest, count, [&](T* ptr, usize) { ConstructAt(ptr, value); });
+        }
+        void ValueConstruct(T* dest, const usize count)
+        {
+            if constexpr (HasPlainConstruct)
+                std::uninitialized_value_construct_n(dest, count);
+            else
+                ConstructN(dest, count, [&](T* ptr, usize) { ConstructAt(ptr); });
+        }
+        // Moves `count` live elements from `src` into the uninitialized storage at `dest` and ends the lifetime
+        // of the originals. Falls back to copying when T's move constructor may throw so that a failure leaves
+        // the source untouched.
+        static void Relocate(T* src, const usize count, T* dest)
+        {
+            if constexpr (IsTriviallyRelocatable<T>::value)
             {
-                T* temp  = m_Buffer;
-                m_Buffer = new T[m_Capacity];
-                if (!m_Buffer)
-                    throw std::bad_alloc();
-                if (prev_size < m_Size)
-                    std::memcpy(m_Buffer, temp, prev_size * sizeof(T));
+                if (count > 0)
+                    std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+            }
+            else
+            {
+                if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                    std::uninitialized_move_n(src, count, dest);
                 else
-                    std::memcpy(m_Buffer, temp, m_Size * sizeof(T));
-                delete[] temp;
+                    std::uninitialized_copy_n(src, count, dest);
+                std::destroy_n(src, count);
+            }
+        }
+        // The capacity to grow to once `required` elements no longer fit, as dictated by the growth policy.
+        usize GrowCapacity(const usize required) const
+        {
+            if (required > std::numeric_limits<usize>::max() / sizeof(T))
+                throw std::length_error("Vector capacity exceeds MaxSize().");
+            return std::max(static_cast<usize>(Growth::Grow(m_Capacity, required, sizeof(T))), required);
+        }
+        void Reallocate(const usize newCapacity)
+        {
+            if constexpr (CanRealloc)
+            {
+                if (newCapacity > MaxSize())
+                    throw std::length_error("Vector capacity exceeds MaxSize().");
+                m_Buffer = m_Allocator.Reallocate(m_Buffer, m_Capacity, newCapacity);
             }
             else
             {
-                if (m_Buffer)
-                    delete[] m_Buffer;
-                m_Buffer = new T[m_Capacity];
-                if (!m_Buffer)
-                    throw std::bad_alloc();
+                T* buffer = Allocate(newCapacity);
+                try
+                {
+                    Relocate(m_Buffer, m_Size, buffer);
+                }
+                catch (...)
+                {
+                    Deallocate(buffer, newCapacity);
+                    throw;
+                }
+                Deallocate(m_Buffer, m_Capacity);
+                m_Buffer = buffer;
             }
+            m_Capacity = newCapacity;
         }
         inline void Drop() noexcept
         {
-            delete[] m_Buffer;
+            std::destroy_n(m_Buffer, m_Size);
+            Deallocate(m_Buffer, m_Capacity);
             m_Buffer   = nullptr;
             m_Size     = 0;
             m_Capacity = 0;
         }
+        // Replaces the contents with `count` elements read from `first`. Already constructed slots are
+        // assigned to, the rest are constructed in place.
+        template <typename It>
+        void AssignRange(It first, const usize count)
+        {
+            if (count > m_Capacity)
+            {
+                T* buffer = Allocate(count);
+                try
+                {
+                    CopyConstruct(first, count, buffer);
+                }
+                catch (...)
+                {
+                    Deallocate(buffer, count);
+                    throw;
+                }
+                Drop();
+                m_Buffer   = buffer;
+                m_Size     = count;
+                m_Capacity = count;
+            }
+            else if (count > m_Size)
+            {
+                std::copy_n(first, m_Size, m_Buffer);
+                CopyConstruct(first + m_Size, count - m_Size, m_Buffer + m_Size);
+                m_Size = count;
+            }
+            else
+            {
+                std::copy_n(first, count, m_Buffer);
+                std::destroy(m_Buffer + count, m_Buffer + m_Size);
+                m_Size = count;
+            }
+        }
+        // Relocates `count` elements from `src` to `dest` within our own buffer, the two ranges may overlap.
+        static void Shift(T* src, const usize count, T* dest) noexcept
+        {
+            if (src == dest)
+                return;
 
-    public:
-        void Push(T e)
+            if constexpr (IsTriviallyRelocatable<T>::value)
+            {
+                if (count > 0)
+                    std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+            }
+            else if (dest > src)
+            {
+                for (usize i = count; i-- > 0;)
+                {
+                    ::new (static_cast<void*>(dest + i)) T(std::move(src[i]));
+                    std::destroy_at(src + i);
+                }
+            }
+            else
+            {
+                for (usize i = 0; i < count; ++i)
+                {
+                    ::new (static_cast<void*>(dest + i)) T(std::move(src[i]));
+                    std::destroy_at(src + i);
+                }
+            }
+        }
+        // Same as Relocate() but leaves `count` uninitialized slots at `index` in `dest`. The old elements are
+        // only destroyed once all of them made it over.
+        void RelocateAround(T* dest, const usize index, const usize count)
         {
-            if (m_Size >= m_Capacity)
+            if constexpr (IsTriviallyRelocatable<T>::value)
             {
-                Realloc(m_Size + 1);
-                m_Buffer[m_Size - 1] = std::move(e);
+                Relocate(m_Buffer, index, dest);
+                Relocate(m_Buffer + index, m_Size - index, dest + index + count);
+            }
+            else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+            {
+                std::uninitialized_move_n(m_Buffer, index, dest);
+                std::uninitialized_move_n(m_Buffer + index, m_Size - index, dest + index + count);
+                std::destroy_n(m_Buffer, m_Size);
+            }
+            else
+            {
+                std::uninitialized_copy_n(m_Buffer, index, dest);
+                try
+                {
+                    std::uninitialized_copy_n(m_Buffer + index, m_Size - index, dest + index + count);
+                }
+                catch (...)
+                {
+                    std::destroy_n(dest, index);
+                    throw;
+                }
+                std::destroy_n(m_Buffer, m_Size);
+            }
+        }
+        // Makes room for `count` elements at `index` and lets `construct` build them in the uninitialized gap.
+        // When the elements fit, the tail is shifted in place, otherwise the new elements are constructed in a
+        // freshly grown buffer first and the old ones are relocated around them in a single pass. Either way a
+        // throwing `construct` leaves the vector as it was.
+        template <typename Fn>
+        void InsertGap(const usize index, const usize count, Fn&& construct)
+        {
+            if (count == 0)
+                return;
+
+            if (m_Size + count <= m_Capacity && CanShiftInPlace)
+            {
+                T* gap = m_Buffer + index;
+                Shift(gap, m_Size - index, gap + count);
+                try
+                {
+                    construct(gap);
+                }
+                catch (...)
+                {
+                    Shift(gap + count, m_Size - index, gap);
+                    throw;
+                }
+            }
+            else
+            {
+                const usize new_capacity = (m_Size + count > m_Capacity) ? GrowCapacity(m_Size + count) : m_Capacity;
+                T*          buffer       = Allocate(new_capacity);
+                try
+                {
+                    construct(buffer + index);
+                }
+                catch (...)
+                {
+                    Deallocate(buffer, new_capacity);
+                    throw;
+                }
+                try
+                {
+                    RelocateAround(buffer, index, count);
+                }
+                catch (...)
+                {
+                    std::destroy_n(buffer + index, count);
+                    Deallocate(buffer, new_capacity);
+                    throw;
+                }
+                Deallocate(m_Buffer, m_Capacity);
+                m_Buffer   = buffer;
+                m_Capacity = new_capacity;
+            }
+            m_Size += count;
+        }
+        void EraseRange(const usize index, const usize count) noexcept(CanShiftInPlace)
+        {
+            if constexpr (CanShiftInPlace)
+            {
+                std::destroy_n(m_Buffer + index, count);
+                Shift(m_Buffer + index + count, m_Size - index - count, m_Buffer + index);
             }
             else
-                m_Buffer[m_Size++] = std::move(e);
+            {
+                std::move(m_Buffer + index + count, m_Buffer + m_Size, m_Buffer + index);
+                std::destroy(m_Buffer + m_Size - count, m_Buffer + m_Size);
+            }
+            m_Size -= count;
         }
+        // Whenever ptr points at one of our live elements, in which case it would be pulled out from under
+        // us by an in place insertion.
+        constexpr bool IsOwnElement(const T* ptr) const noexcept
+        {
+            return std::less_equal<const T*>{}(m_Buffer, ptr) && std::less<const T*>{}(ptr, m_Buffer + m_Size);
+        }
+
+    public:
+        void Push(const T& e) { EmplaceBack(e); }
+        void Push(T&& e) { EmplaceBack(std::move(e)); }
         inline T Pop()
         {
             if (m_Size > 0)
-                return std::move(m_Buffer[m_Size--]);
+            {
+                T obj = std::move(m_Buffer[--m_Size]);
+                std::destroy_at(m_Buffer + m_Size);
+                return obj;
+            }
             else
                 throw std::out_of_range("Tried calling Pop() on an empty vector.");
         }
@@ -285,162 +589,277 @@ namespace my {
         }
         void Assign(const usize count, const T& value)
         {
-            Realloc(count);
-            std::fill(begin(), end(), value);
+            if (count > m_Capacity)
+            {
+                // Build the new buffer before tearing down the old one in case value lives inside of it.
+                T* buffer = Allocate(count);
+                try
+                {
+                    FillConstruct(buffer, count, value);
+                }
+                catch (...)
+                {
+                    Deallocate(buffer, count);
+                    throw;
+                }
+                Drop();
+                m_Buffer   = buffer;
+                m_Size     = count;
+                m_Capacity = count;
+            }
+            else if (count > m_Size)
+            {
+                std::fill_n(m_Buffer, m_Size, value);
+                FillConstruct(m_Buffer + m_Size, count - m_Size, value);
+                m_Size = count;
+            }
+            else
+            {
+                std::fill_n(m_Buffer, count, value);
+                std::destroy(m_Buffer + count, m_Buffer + m_Size);
+                m_Size = count;
+            }
         }
         void Assign(const ConstIterator begin, const ConstIterator end)
         {
-            Realloc(end - begin);
-            std::copy(begin, end, this->begin());
-        }
-        void Assign(const std::initializer_list<T> list)
-        {
-            Realloc(list.size());
-            std::copy(list.begin(), list.end(), begin());
+            AssignRange(begin.operator->(), end - begin);
         }
-        constexpr void Swap(Vec<T>& other)
+        void Assign(const std::initializer_list<T> list) { AssignRange(list.begin(), list.size()); }
+        constexpr void Swap(Vec<T, Growth, Alloc>& other) noexcept
         {
+            if constexpr (AllocTraits::propagate_on_container_swap::value)
+                std::swap(m_Allocator, other.m_Allocator);
             std::swap(m_Size, other.m_Size);
             std::swap(m_Capacity, other.m_Capacity);
             std::swap(m_Buffer, other.m_Buffer);
         }
-        inline void Resize(const usize newSize) { Realloc(newSize); }
-        void        Insert(const ConstIterator pos, const T& value)
+        void Resize(const usize newSize)
         {
-            const auto diff = pos - begin();
-            const T*   temp = m_Buffer;
-
-            ++m_Size;
-            m_Capacity = m_Size * 2;
-            m_Buffer   = new T[m_Capacity];
-            std::copy(temp, temp + diff, m_Buffer);
-            m_Buffer[diff] = value;
-            std::copy(temp + diff, temp + m_Size - 1, m_Buffer + diff + 1);
-
-            delete[] temp;
+            if (newSize > m_Size)
+            {
+                if (newSize > m_Capacity)
+                    Reallocate(GrowCapacity(newSize));
+                ValueConstruct(m_Buffer + m_Size, newSize - m_Size);
+            }
+            else
+                std::destroy(m_Buffer + newSize, m_Buffer + m_Size);
+            m_Size = newSize;
         }
-        void Insert(const ConstIterator pos, const ConstIterator first, const ConstIterator last)
+        void Insert(const ConstIterator pos, const T& value)
         {
-            const auto  diff        = pos - begin();
-            const usize insert_size = last - first;
-            const usize prev_size   = m_Size;
-            T*          temp        = m_Buffer;
-
-            m_Size += insert_size;
-            m_Capacity = m_Size * 2;
-            m_Buffer   = new T[m_Capacity];
-            std::copy(temp, temp + diff, m_Buffer);
-            std::copy(first, last, m_Buffer + diff);
-            std::copy(temp + diff, temp + prev_size, m_Buffer + diff + insert_size);
-
-            delete[] temp;
+            const usize index = pos - begin();
+            if (index == m_Size)
+                EmplaceBack(value);
+            else if (IsOwnElement(&value))
+                Insert(pos, T(value));
+            else
+                InsertGap(index, 1, [&](T* dest) { ConstructAt(dest, value); });
         }
-        void Erase(const ConstIterator pos)
+        void Insert(const ConstIterator pos, T&& value)
         {
-            if (!Empty())
+            const usize index = pos - begin();
+            if (index == m_Size)
+                EmplaceBack(std::move(value));
+            else if (IsOwnElement(&value))
+                Insert(pos, T(std::move(value)));
+            else
+                InsertGap(index, 1, [&](T* dest) { ConstructAt(dest, std::move(value)); });
+        }
+        void Insert(const ConstIterator pos, const usize count, const T& value)
+        {
+            const usize index = pos - begin();
+            if (IsOwnElement(&value))
             {
-                const usize   prev_size = m_Size;
-                const ptrdiff index     = pos - begin();
-
-                T* temp = m_Buffer;
-                --m_Size;
-                m_Capacity = m_Size * 2;
-                m_Buffer   = new T[m_Capacity];
+                const T copy = value;
+                InsertGap(index, count, [&](T* dest) { FillConstruct(dest, count, copy); });
+            }
+            else
+                InsertGap(index, count, [&](T* dest) { FillConstruct(dest, count, value); });
+        }
+        // Inserts the whole range with a single shift of the tail. Single pass input iterators are buffered
+        // up first since their length is not known in advance.
+        template <typename It>
+            requires std::derived_from<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>
+        void Insert(const ConstIterator pos, It first, It last)
+        {
+            const usize index = pos - begin();
+            if constexpr (std::derived_from<typename std::iterator_traits<It>::iterator_category,
+                                            std::forward_iterator_tag>)
+            {
+                const usize count = std::distance(first, last);
+                if (count == 0)
+                    return;
 
-                for (usize i = 0, j = 0; i < prev_size; ++i)
-                    if (i != index)
-                        m_Buffer[j++] = temp[i];
-                delete[] temp;
+                // A range out of our own buffer has to be copied out first, shifting would trample it.
+                if constexpr (std::is_pointer_v<It> || std::is_same_v<It, Iterator> || std::is_same_v<It, ConstIterator>)
+                {
+                    if (IsOwnElement(&*first))
+                    {
+                        Vec<T, Growth, Alloc> range(m_Allocator);
+                        range.AssignRange(&*first, count);
+                        InsertGap(index, count, [&](T* dest) {
+                            CopyConstruct(std::make_move_iterator(range.m_Buffer), count, dest);
+                        });
+                        return;
+                    }
+                }
+                InsertGap(index, count, [&](T* dest) { CopyConstruct(first, count, dest); });
+            }
+            else
+            {
+                Vec<T, Growth, Alloc> range(m_Allocator);
+                for (; first != last; ++first)
+                    range.EmplaceBack(*first);
+                InsertGap(index, range.m_Size, [&](T* dest) {
+                    CopyConstruct(std::make_move_iterator(range.m_Buffer), range.m_Size, dest);
+                });
             }
+        }
+        void Insert(const ConstIterator pos, const std::initializer_list<T> list)
+        {
+            Insert(pos, list.begin(), list.end());
+        }
+        void Erase(const ConstIterator pos)
+        {
+            if (!Empty())
+                EraseRange(pos - begin(), 1);
             else
                 throw std::out_of_range("Tried calling Erase() on an empty vector.");
         }
-        constexpr void Reserve(const usize newCapacity)
+        void Reserve(const usize newCapacity)
         {
             if (newCapacity > m_Capacity)
-            {
-                const usize prev_capacity = m_Capacity;
-                m_Capacity                = newCapacity;
-                T* temp                   = m_Buffer;
-                m_Buffer                  = new T[m_Capacity];
-                std::memcpy(m_Buffer, m_Capacity, prev_capacity * sizeof(T));
-                delete[] temp;
-            }
+                Reallocate(newCapacity);
         }
         void Erase(const ConstIterator first, const ConstIterator last)
         {
             if (!Empty())
-            {
-                const usize prev_size = m_Size;
-                T*          temp      = m_Buffer;
-                m_Size -= last - first;
-                m_Capacity = m_Size * 2;
-                m_Buffer   = new T[m_Capacity];
-
-                std::copy(temp, temp + (first - temp), m_Buffer);
-                std::copy(temp + (last - first) + (first - temp), temp + prev_size, m_Buffer + (first - temp));
-
-                delete[] temp;
-            }
+                EraseRange(first - begin(), last - first);
             else
                 throw std::out_of_range("Tried calling Erase() on an empty vector.");
         }
-        inline void    ShrinkToFit() { Realloc(m_Size, false); }
-        constexpr void Clear() noexcept { m_Size = 0; }
+        void ShrinkToFit()
+        {
+            if (m_Size == 0)
+                Drop();
+            else if (m_Capacity > m_Size)
+                Reallocate(m_Size);
+        }
+        void Clear() noexcept
+        {
+            std::destroy_n(m_Buffer, m_Size);
+            m_Size = 0;
+        }
 
     public:
         template <typename... TArgs>
-        void Emplace(const Iterator pos, TArgs&&... args)
+        void Emplace(const ConstIterator pos, TArgs&&... args)
         {
-            const auto diff = pos - begin();
-            const T*   temp = m_Buffer;
-
-            ++m_Size;
-            m_Capacity = m_Size * 2;
-            m_Buffer   = new T[m_Capacity];
-
-            std::copy(temp, temp + diff, m_Buffer);
-            m_Buffer[diff] = T(std::forward<TArgs>(args)...);
-            std::copy(temp + diff, temp + m_Size - 1, m_Buffer + diff + 1);
-
-            delete[] temp;
+            const usize index = pos - begin();
+            if (index == m_Size)
+                EmplaceBack(std::forward<TArgs>(args)...);
+            else if (m_Size < m_Capacity && CanShiftInPlace)
+            {
+                // args may refer to our own elements which are about to be shifted, so build the element
+                // up front and move it into the gap afterwards.
+                T obj(std::forward<TArgs>(args)...);
+                InsertGap(index, 1, [&](T* dest) { ConstructAt(dest, std::move(obj)); });
+            }
+            else
+                InsertGap(index, 1, [&](T* dest) { ConstructAt(dest, std::forward<TArgs>(args)...); });
         }
         template <typename... TArgs>
-        void EmplaceBack(TArgs&&... args)
+        T& EmplaceBack(TArgs&&... args)
         {
-            if (m_Size >= m_Capacity)
+            if (m_Size < m_Capacity)
             {
-                Realloc(m_Size + 1);
-                m_Buffer[m_Size - 1] = T(std::forward<TArgs>(args)...);
+                ConstructAt(m_Buffer + m_Size, std::forward<TArgs>(args)...);
+                return m_Buffer[m_Size++];
+            }
+
+            // args may refer to an element of ours, so the new element has to be constructed before the old
+            // buffer goes away.
+            const usize new_capacity = GrowCapacity(m_Size + 1);
+            if constexpr (CanRealloc)
+            {
+                T obj(std::forward<TArgs>(args)...);
+                Reallocate(new_capacity);
+                ConstructAt(m_Buffer + m_Size, std::move(obj));
             }
             else
-                m_Buffer[m_Size++] = T(std::forward<TArgs>(args)...);
+            {
+                T* buffer = Allocate(new_capacity);
+                try
+                {
+                    ConstructAt(buffer + m_Size, std::forward<TArgs>(args)...);
+                }
+                catch (...)
+                {
+                    Deallocate(buffer, new_capacity);
+                    throw;
+                }
+                try
+                {
+                    Relocate(m_Buffer, m_Size, buffer);
+                }
+                catch (...)
+                {
+                    std::destroy_at(buffer + m_Size);
+                    Deallocate(buffer, new_capacity);
+                    throw;
+                }
+                Deallocate(m_Buffer, m_Capacity);
+                m_Buffer   = buffer;
+                m_Capacity = new_capacity;
+            }
+            return m_Buffer[m_Size++];
         }
 
     public:
         constexpr T&       operator[](const usize index) noexcept { return m_Buffer[index]; }
         constexpr const T& operator[](const usize index) const noexcept { return m_Buffer[index]; }
-        inline Vec<T>&     operator=(const std::initializer_list<T> list)
+        inline Vec<T, Growth, Alloc>& operator=(const std::initializer_list<T> list)
         {
-            Realloc(list.size());
-            std::copy(list.begin(), list.end(), begin());
+            AssignRange(list.begin(), list.size());
             return *this;
         }
-        inline Vec<T>& operator=(const Vec<T>& other)
+        inline Vec<T, Growth, Alloc>& operator=(const Vec<T, Growth, Alloc>& other)
         {
             if (&other == this)
                 return *this;
 
-            Realloc(other.m_Size);
-            std::memcpy(m_Buffer, other.m_Buffer, m_Size * sizeof(T));
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                // Our buffer came from our allocator so it has to go back to it before we adopt theirs.
+                if (m_Allocator != other.m_Allocator)
+                    Drop();
+                m_Allocator = other.m_Allocator;
+            }
+            AssignRange(other.m_Buffer, other.m_Size);
             return *this;
         }
-        inline Vec<T>& operator=(Vec<T>&& other) noexcept
+        inline Vec<T, Growth, Alloc>& operator=(Vec<T, Growth, Alloc>&& other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
         {
             if (&other == this)
                 return *this;
 
+            if constexpr (!AllocTraits::propagate_on_container_move_assignment::value &&
+                          !AllocTraits::is_always_equal::value)
+            {
+                // The buffer belongs to a different memory resource that we cannot free into, so the
+                // elements have to be moved over one by one instead.
+                if (m_Allocator != other.m_Allocator)
+                {
+                    AssignRange(std::make_move_iterator(other.m_Buffer), other.m_Size);
+                    other.Clear();
+                    return *this;
+                }
+            }
+
             Drop();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+                m_Allocator = std::move(other.m_Allocator);
             m_Size           = other.m_Size;
             m_Capacity       = other.m_Capacity;
             other.m_Size     = 0;
@@ -448,19 +867,20 @@ namespace my {
             std::swap(m_Buffer, other.m_Buffer);
             return *this;
         }
-        inline Vec<T>& operator<<(const Vec<T>& other)
+        inline Vec<T, Growth, Alloc>& operator<<(const Vec<T, Growth, Alloc>& other)
         {
             if (&other == this)
                 return *this;
 
-            const usize prev_size = m_Size;
-            Realloc(m_Size + other.m_Size);
-            std::copy(other.begin(), other.end(), begin() + prev_size);
+            if (m_Size + other.m_Size > m_Capacity)
+                Reallocate(GrowCapacity(m_Size + other.m_Size));
+            CopyConstruct(other.m_Buffer, other.m_Size, m_Buffer + m_Size);
+            m_Size += other.m_Size;
             return *this;
         }
 
     public:
-        friend std::ostream& operator<<(std::ostream& stream, const Vec<T>& other)
+        friend std::ostream& operator<<(std::ostream& stream, const Vec<T, Growth, Alloc>& other)
         {
             stream << "[ ";
             for (usize i = 0; i < other.m_Size; ++i)
@@ -475,6 +895,7 @@ namespace my {
         }
     };
 
+
     template <>
     class Vec<bool>
     {
@@ -1102,4 +1523,9 @@ namespace my {
     };
 } // namespace my
 
+namespace my::pmr {
+    template <typename T, IsGrowthPolicy Growth = DefaultGrowth>
+    using Vec = my::Vec<T, Growth, std::pmr::polymorphic_allocator<T>>;
+} // namespace my::pmr
+
 #endif // MY_VECTOR_H
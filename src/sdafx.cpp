@@ -1,7 +1,13 @@
-// #include <BinaryTree.h>
+#include <BTree.h>
+#include <BinaryTree.h>
+#include <ConcurrentHashMap.h>
+#include <FlatMap.h>
+#include <FlatSet.h>
 #include <ForwardList.h>
+#include <FrozenTree.h>
 // #include <Graph.h>
 #include <HashMap.h>
+#include <MappedHashMap.h>
 #include <Queue.h>
 #include <Stack.h>
 #include <Vector.h>